@@ -38,4 +38,33 @@ struct BitmapConstRef {
 
 };
 
+/// A rectangular region of a bitmap spanning the pixel columns [x0, x1) and rows [y0, y1).
+struct BitmapRegion {
+
+    int x0, y0, x1, y1;
+
+    inline BitmapRegion() : x0(0), y0(0), x1(0), y1(0) { }
+    inline BitmapRegion(int x0, int y0, int x1, int y1) : x0(x0), y0(y0), x1(x1), y1(y1) { }
+
+    /// Returns the intersection of the region with the pixels of a bitmap with the given dimensions.
+    inline BitmapRegion clamp(int width, int height) const {
+        BitmapRegion region(x0 > 0 ? x0 : 0, y0 > 0 ? y0 : 0, x1 < width ? x1 : width, y1 < height ? y1 : height);
+        if (region.x1 < region.x0)
+            region.x1 = region.x0;
+        if (region.y1 < region.y0)
+            region.y1 = region.y0;
+        return region;
+    }
+
+    /// Returns the region expanded by the given number of pixels in each direction.
+    inline BitmapRegion expand(int border) const {
+        return BitmapRegion(x0-border, y0-border, x1+border, y1+border);
+    }
+
+    inline bool empty() const {
+        return x1 <= x0 || y1 <= y0;
+    }
+
+};
+
 }
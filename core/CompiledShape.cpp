@@ -0,0 +1,100 @@
+#include "CompiledShape.h"
+
+namespace msdfgen {
+
+CompiledShape::CompiledShape() {
+    contourOffsets.push_back(0);
+}
+
+CompiledShape::CompiledShape(const Shape &shape, double cubicSearchTolerance) {
+    build(shape, cubicSearchTolerance);
+}
+
+void CompiledShape::build(const Shape &shape, double cubicSearchTolerance) {
+    linearSegments.clear();
+    quadraticSegments.clear();
+    cubicSegments.clear();
+    otherSegments.clear();
+    edges.clear();
+    edgeTypes.clear();
+    coefficients.clear();
+    floatCoefficients.clear();
+    geometries.clear();
+    floatGeometries.clear();
+    contourOffsets.clear();
+    // The edges are first copied to the array of their type and referenced by their index in it, since the arrays may still be reallocated.
+    std::vector<int> typeIndices;
+    for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour) {
+        contourOffsets.push_back((int) edgeTypes.size());
+        for (std::vector<EdgeHolder>::const_iterator edge = contour->edges.begin(); edge != contour->edges.end(); ++edge) {
+            int type = (*edge)->type();
+            switch (type) {
+                case LinearSegment::EDGE_TYPE:
+                    typeIndices.push_back((int) linearSegments.size());
+                    linearSegments.push_back(*static_cast<const LinearSegment *>((const EdgeSegment *) *edge));
+                    break;
+                case QuadraticSegment::EDGE_TYPE:
+                    typeIndices.push_back((int) quadraticSegments.size());
+                    quadraticSegments.push_back(*static_cast<const QuadraticSegment *>((const EdgeSegment *) *edge));
+                    break;
+                case CubicSegment::EDGE_TYPE:
+                    typeIndices.push_back((int) cubicSegments.size());
+                    cubicSegments.push_back(*static_cast<const CubicSegment *>((const EdgeSegment *) *edge));
+                    break;
+                default:
+                    type = 0;
+                    typeIndices.push_back((int) otherSegments.size());
+                    otherSegments.push_back(EdgeHolder((*edge)->clone()));
+            }
+            edgeTypes.push_back(type);
+        }
+    }
+    contourOffsets.push_back((int) edgeTypes.size());
+    edges.resize(edgeTypes.size());
+    for (int i = 0; i < (int) edges.size(); ++i) {
+        switch (edgeTypes[i]) {
+            case LinearSegment::EDGE_TYPE:
+                edges[i] = &linearSegments[typeIndices[i]];
+                break;
+            case QuadraticSegment::EDGE_TYPE:
+                edges[i] = &quadraticSegments[typeIndices[i]];
+                break;
+            case CubicSegment::EDGE_TYPE:
+                edges[i] = &cubicSegments[typeIndices[i]];
+                break;
+            default:
+                edges[i] = otherSegments[typeIndices[i]];
+        }
+    }
+    coefficients.resize(edges.size());
+    floatCoefficients.resize(edges.size());
+    for (int i = 0; i < (int) edges.size(); ++i) {
+        switch (edgeTypes[i]) {
+            case LinearSegment::EDGE_TYPE:
+                static_cast<const LinearSegment *>(edges[i])->getCoefficients(coefficients[i]);
+                static_cast<const LinearSegment *>(edges[i])->getCoefficients(floatCoefficients[i]);
+                break;
+            case QuadraticSegment::EDGE_TYPE:
+                static_cast<const QuadraticSegment *>(edges[i])->getCoefficients(coefficients[i]);
+                static_cast<const QuadraticSegment *>(edges[i])->getCoefficients(floatCoefficients[i]);
+                break;
+            case CubicSegment::EDGE_TYPE:
+                static_cast<const CubicSegment *>(edges[i])->getCoefficients(coefficients[i], cubicSearchTolerance);
+                static_cast<const CubicSegment *>(edges[i])->getCoefficients(floatCoefficients[i], cubicSearchTolerance);
+                break;
+        }
+    }
+    geometries.reserve(edges.size());
+    floatGeometries.reserve(edges.size());
+    for (int contourIndex = 0; contourIndex < contourCount(); ++contourIndex) {
+        int begin = contourOffsets[contourIndex], n = contourOffsets[contourIndex+1]-begin;
+        for (int i = 0; i < n; ++i) {
+            const EdgeSegment *prevEdge = edges[begin+(i+n-1)%n];
+            const EdgeSegment *nextEdge = edges[begin+(i+1)%n];
+            geometries.push_back(EdgeGeometry(prevEdge, edges[begin+i], nextEdge));
+            floatGeometries.push_back(FloatEdgeGeometry(prevEdge, edges[begin+i], nextEdge));
+        }
+    }
+}
+
+}
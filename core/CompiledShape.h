@@ -0,0 +1,135 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include "Vector2.hpp"
+#include "SignedDistance.hpp"
+#include "edge-segments.h"
+#include "edge-selectors.h"
+#include "Shape.h"
+
+namespace msdfgen {
+
+/**
+ * An immutable copy of the edges of a Shape for fast distance queries.
+ * The edge segments of each type are stored by value in a contiguous array instead of being individually allocated behind EdgeHolder,
+ * and the edges of all contours are numbered consecutively in the order of the shape's contours and their edges.
+ * The signedDistance functions select the edge's implementation with a switch over its type instead of a virtual call
+ * and use the edge's coefficients precomputed by build, which also precomputes the geometry of each edge and its neighbors used by the edge selectors.
+ */
+class CompiledShape {
+
+public:
+    CompiledShape();
+    explicit CompiledShape(const Shape &shape, double cubicSearchTolerance = 0);
+    /// Builds the representation of shape in a single pass. The edges are copied, so the shape may be modified afterwards without affecting it.
+    /// If cubicSearchTolerance is positive, the nearest point search of cubic curves is adapted to the tolerance in shape units (see CubicSegment::getCoefficients).
+    void build(const Shape &shape, double cubicSearchTolerance = 0);
+    /// Returns the number of contours, including empty ones.
+    int contourCount() const;
+    /// Returns the index of the first edge of the specified contour.
+    int contourBegin(int contourIndex) const;
+    /// Returns the index following the last edge of the specified contour.
+    int contourEnd(int contourIndex) const;
+    /// Returns the total number of edges.
+    int edgeCount() const;
+    /// Returns the index of the contour of the edge with the specified index.
+    int edgeContour(int edgeIndex) const;
+    /// Returns the edge with the specified index.
+    const EdgeSegment *edge(int edgeIndex) const;
+    /// Returns the numeric code of the edge's type, or 0 for edge types other than LinearSegment, QuadraticSegment, and CubicSegment.
+    int edgeType(int edgeIndex) const;
+    /// Returns the precomputed geometry of the edge and its neighbors in its contour in the specified precision.
+    template <typename T>
+    const BasicEdgeGeometry<T> &geometry(int edgeIndex) const;
+    /// Returns the minimum signed distance between origin and the edge, same as EdgeSegment::signedDistance.
+    SignedDistance signedDistance(int edgeIndex, const Point2 &origin, double &param) const;
+    FloatSignedDistance signedDistance(int edgeIndex, const FloatPoint2 &origin, float &param) const;
+
+private:
+    std::vector<LinearSegment> linearSegments;
+    std::vector<QuadraticSegment> quadraticSegments;
+    std::vector<CubicSegment> cubicSegments;
+    /// Copies of edges of other types, which are dispatched virtually.
+    std::vector<EdgeHolder> otherSegments;
+    std::vector<const EdgeSegment *> edges;
+    std::vector<int> edgeTypes;
+    /// The precomputed coefficients of edges of the above types in double and single precision.
+    std::vector<EdgeCoefficients> coefficients;
+    std::vector<FloatEdgeCoefficients> floatCoefficients;
+    std::vector<EdgeGeometry> geometries;
+    std::vector<FloatEdgeGeometry> floatGeometries;
+    /// The index of the first edge of each contour, followed by the total number of edges.
+    std::vector<int> contourOffsets;
+
+    // Not copyable because edges points into the arrays of segments.
+    CompiledShape(const CompiledShape &);
+    CompiledShape &operator=(const CompiledShape &);
+
+};
+
+inline int CompiledShape::contourCount() const {
+    return (int) contourOffsets.size()-1;
+}
+
+inline int CompiledShape::contourBegin(int contourIndex) const {
+    return contourOffsets[contourIndex];
+}
+
+inline int CompiledShape::contourEnd(int contourIndex) const {
+    return contourOffsets[contourIndex+1];
+}
+
+inline int CompiledShape::edgeCount() const {
+    return (int) edges.size();
+}
+
+inline int CompiledShape::edgeContour(int edgeIndex) const {
+    return int(std::upper_bound(contourOffsets.begin(), contourOffsets.end(), edgeIndex)-contourOffsets.begin())-1;
+}
+
+inline const EdgeSegment *CompiledShape::edge(int edgeIndex) const {
+    return edges[edgeIndex];
+}
+
+inline int CompiledShape::edgeType(int edgeIndex) const {
+    return edgeTypes[edgeIndex];
+}
+
+template <>
+inline const EdgeGeometry &CompiledShape::geometry<double>(int edgeIndex) const {
+    return geometries[edgeIndex];
+}
+
+template <>
+inline const FloatEdgeGeometry &CompiledShape::geometry<float>(int edgeIndex) const {
+    return floatGeometries[edgeIndex];
+}
+
+inline SignedDistance CompiledShape::signedDistance(int edgeIndex, const Point2 &origin, double &param) const {
+    const EdgeSegment *edge = edges[edgeIndex];
+    switch (edgeTypes[edgeIndex]) {
+        case LinearSegment::EDGE_TYPE:
+            return LinearSegment::signedDistance(coefficients[edgeIndex], origin, param);
+        case QuadraticSegment::EDGE_TYPE:
+            return QuadraticSegment::signedDistance(coefficients[edgeIndex], origin, param);
+        case CubicSegment::EDGE_TYPE:
+            return CubicSegment::signedDistance(coefficients[edgeIndex], origin, param);
+    }
+    return edge->signedDistance(origin, param);
+}
+
+inline FloatSignedDistance CompiledShape::signedDistance(int edgeIndex, const FloatPoint2 &origin, float &param) const {
+    const EdgeSegment *edge = edges[edgeIndex];
+    switch (edgeTypes[edgeIndex]) {
+        case LinearSegment::EDGE_TYPE:
+            return LinearSegment::signedDistance(floatCoefficients[edgeIndex], origin, param);
+        case QuadraticSegment::EDGE_TYPE:
+            return QuadraticSegment::signedDistance(floatCoefficients[edgeIndex], origin, param);
+        case CubicSegment::EDGE_TYPE:
+            return CubicSegment::signedDistance(floatCoefficients[edgeIndex], origin, param);
+    }
+    return edge->signedDistance(origin, param);
+}
+
+}
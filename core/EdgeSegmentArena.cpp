@@ -0,0 +1,69 @@
+#include "EdgeSegmentArena.h"
+
+#include <new>
+#include "arithmetics.hpp"
+
+namespace msdfgen {
+
+/// The alignment of the allocated memory, which is sufficient for edge segments.
+static const size_t ARENA_ALIGNMENT = 16;
+
+#ifdef MSDFGEN_USE_CPP11
+static thread_local EdgeSegmentArena *currentArena = NULL;
+#else
+static EdgeSegmentArena *currentArena = NULL;
+#endif
+
+EdgeSegmentArena::Scope::Scope(EdgeSegmentArena *arena) : prevArena(setCurrent(arena)) { }
+
+EdgeSegmentArena::Scope::~Scope() {
+    setCurrent(prevArena);
+}
+
+EdgeSegmentArena *EdgeSegmentArena::current() {
+    return currentArena;
+}
+
+EdgeSegmentArena *EdgeSegmentArena::setCurrent(EdgeSegmentArena *arena) {
+    EdgeSegmentArena *prevArena = currentArena;
+    currentArena = arena;
+    return prevArena;
+}
+
+EdgeSegmentArena::EdgeSegmentArena(size_t blockSize) : blockSize(blockSize), curBlock(0), curOffset(0) { }
+
+EdgeSegmentArena::~EdgeSegmentArena() {
+    for (std::vector<Block>::const_iterator block = blocks.begin(); block != blocks.end(); ++block)
+        ::operator delete(block->memory);
+}
+
+void *EdgeSegmentArena::allocate(size_t size) {
+    size = (size+ARENA_ALIGNMENT-1)&~(ARENA_ALIGNMENT-1);
+    // Continue with the next block (kept from before the last reset) if the current one is full.
+    for (; curBlock < blocks.size(); ++curBlock, curOffset = 0) {
+        if (curOffset+size <= blocks[curBlock].size) {
+            void *memory = blocks[curBlock].memory+curOffset;
+            curOffset += size;
+            return memory;
+        }
+    }
+    Block block;
+    block.size = max(blockSize, size);
+    block.memory = static_cast<char *>(::operator new(block.size));
+    blocks.push_back(block);
+    curOffset = size;
+    return block.memory;
+}
+
+void EdgeSegmentArena::reset() {
+    curBlock = 0, curOffset = 0;
+}
+
+size_t EdgeSegmentArena::capacity() const {
+    size_t total = 0;
+    for (std::vector<Block>::const_iterator block = blocks.begin(); block != blocks.end(); ++block)
+        total += block->size;
+    return total;
+}
+
+}
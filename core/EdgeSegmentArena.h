@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace msdfgen {
+
+/// The default size in bytes of the blocks of memory of EdgeSegmentArena.
+#define MSDFGEN_EDGE_SEGMENT_ARENA_BLOCK_SIZE 65536
+
+/**
+ * An arena from which edge segments are allocated while it is the current arena of the thread that creates them (see Scope).
+ * This covers all edge segments, including those created by EdgeSegment::create, EdgeHolder, clone, splitInThirds, and the shape importers.
+ * Deleting an edge segment allocated from an arena does not free its memory, which is freed all at once when the arena is destroyed,
+ * or reused for new edge segments after reset. The arena must therefore outlive all shapes whose edges were allocated from it.
+ * Without MSDFGEN_USE_CPP11, the current arena is shared by all threads.
+ */
+class EdgeSegmentArena {
+
+public:
+    /// Makes an arena the current arena of the calling thread for the lifetime of the Scope object, and then restores the previous one.
+    class Scope {
+
+    public:
+        explicit Scope(EdgeSegmentArena *arena);
+        ~Scope();
+
+    private:
+        EdgeSegmentArena *prevArena;
+
+        Scope(const Scope &);
+        Scope &operator=(const Scope &);
+
+    };
+
+    /// Returns the current arena of the calling thread, or NULL if edge segments are allocated on the heap.
+    static EdgeSegmentArena *current();
+    /// Sets the current arena of the calling thread, or NULL to allocate edge segments on the heap, and returns the previous one.
+    static EdgeSegmentArena *setCurrent(EdgeSegmentArena *arena);
+
+    explicit EdgeSegmentArena(size_t blockSize = MSDFGEN_EDGE_SEGMENT_ARENA_BLOCK_SIZE);
+    ~EdgeSegmentArena();
+    /// Allocates size bytes of memory aligned for any edge segment.
+    void *allocate(size_t size);
+    /// Makes all of the arena's memory available for reuse without freeing it. All edge segments allocated from the arena must have been destroyed.
+    void reset();
+    /// Returns the total size in bytes of the blocks of memory held by the arena.
+    size_t capacity() const;
+
+private:
+    struct Block {
+        char *memory;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    size_t blockSize;
+    /// The index of the block from which memory is allocated, and the number of its bytes already in use.
+    size_t curBlock, curOffset;
+
+    EdgeSegmentArena(const EdgeSegmentArena &);
+    EdgeSegmentArena &operator=(const EdgeSegmentArena &);
+
+};
+
+}
@@ -2,14 +2,17 @@
 #include "MSDFErrorCorrection.h"
 
 #include <cstring>
+#include <vector>
 #include "arithmetics.hpp"
 #include "equation-solver.h"
 #include "EdgeColor.h"
 #include "bitmap-interpolation.hpp"
+#include "pixel-conversion.hpp"
 #include "edge-selectors.h"
 #include "contour-combiners.h"
 #include "ShapeDistanceFinder.h"
 #include "generator-config.h"
+#include "ThreadPool.h"
 
 namespace msdfgen {
 
@@ -22,6 +25,117 @@ namespace msdfgen {
 MSDFGEN_PUBLIC const double ErrorCorrectionConfig::defaultMinDeviationRatio = 1.11111111111111111;
 MSDFGEN_PUBLIC const double ErrorCorrectionConfig::defaultMinImproveRatio = 1.11111111111111111;
 
+/// Provides the texels of an SDF with pixel type T as floating-point values, which are converted into its own storage unless T is float.
+template <typename T, int N>
+class TexelLoader {
+public:
+    inline const float *operator()(const T *texel) {
+        for (int i = 0; i < N; ++i)
+            values[i] = pixelToFloat(texel[i]);
+        return values;
+    }
+private:
+    float values[N];
+};
+
+template <int N>
+class TexelLoader<float, N> {
+public:
+    inline const float *operator()(const float *texel) const {
+        return texel;
+    }
+};
+
+/// Returns the texels as floating-point values, which are converted into buffer unless they already are.
+template <typename T>
+static const float *convertTexels(std::vector<float> &buffer, const T *texels, int count) {
+    buffer.resize(count);
+    for (int i = 0; i < count; ++i)
+        buffer[i] = pixelToFloat(texels[i]);
+    return &buffer[0];
+}
+
+static const float *convertTexels(std::vector<float> &, const float *texels, int) {
+    return texels;
+}
+
+/// Provides the texels of a range of rows of an SDF with pixel type T as floating-point values together with their medians, each of which is computed only once.
+template <typename T, int N>
+class TexelBand {
+public:
+    /// Loads rows [yBegin, yEnd) of sdf, which must not be empty.
+    void load(const BitmapConstRef<T, N> &sdf, int yBegin, int yEnd) {
+        width = sdf.width;
+        rowBegin = yBegin;
+        int count = width*(yEnd-yBegin);
+        texels = convertTexels(values, sdf(0, yBegin), N*count);
+        medians.resize(count);
+        for (int i = 0; i < count; ++i)
+            medians[i] = median(texels[N*i], texels[N*i+1], texels[N*i+2]);
+    }
+    inline const float *operator()(int x, int y) const {
+        return texels+N*(width*(y-rowBegin)+x);
+    }
+    inline float medianAt(int x, int y) const {
+        return medians[width*(y-rowBegin)+x];
+    }
+private:
+    int width, rowBegin;
+    const float *texels;
+    std::vector<float> values;
+    std::vector<float> medians;
+};
+
+/// Processes the rows of texels of an SDF in parallel bands of MSDFGEN_PARALLEL_TILE_SIZE rows. Each worker passes the bands to its own copy of bandOperation as bandOperation(yBegin, yEnd).
+template <class BandOperation>
+class TexelBandJob {
+
+public:
+    class Worker {
+    public:
+        inline explicit Worker(const TexelBandJob &job) : job(job), bandOperation(job.bandOperation) { }
+        void operator()(int band) {
+            bandOperation(MSDFGEN_PARALLEL_TILE_SIZE*band, min(MSDFGEN_PARALLEL_TILE_SIZE*(band+1), job.height));
+        }
+    private:
+        const TexelBandJob &job;
+        BandOperation bandOperation;
+    };
+
+    inline TexelBandJob(int height, const BandOperation &bandOperation) : height(height), bandOperation(bandOperation) { }
+
+    inline int bandCount() const {
+        return (height+MSDFGEN_PARALLEL_TILE_SIZE-1)/MSDFGEN_PARALLEL_TILE_SIZE;
+    }
+
+private:
+    int height;
+    const BandOperation &bandOperation;
+
+};
+
+template <class BandOperation>
+static void processTexelBands(int height, const BandOperation &bandOperation, int threadCount) {
+    TexelBandJob<BandOperation> job(height, bandOperation);
+    runParallelTasks(job.bandCount(), resolveThreadCount(threadCount), job);
+}
+
+/// Computes the floating-point values of the SDF bilinearly interpolated at pos, the same as interpolate if T is float.
+template <typename T, int N>
+static void interpolateTexels(float *output, const BitmapConstRef<T, N> &sdf, Point2 pos) {
+    pos -= .5;
+    int l = (int) floor(pos.x);
+    int b = (int) floor(pos.y);
+    int r = l+1;
+    int t = b+1;
+    double lr = pos.x-l;
+    double bt = pos.y-b;
+    l = clamp(l, sdf.width-1), r = clamp(r, sdf.width-1);
+    b = clamp(b, sdf.height-1), t = clamp(t, sdf.height-1);
+    for (int i = 0; i < N; ++i)
+        output[i] = mix(mix(pixelToFloat(sdf(l, b)[i]), pixelToFloat(sdf(r, b)[i]), lr), mix(pixelToFloat(sdf(l, t)[i]), pixelToFloat(sdf(r, t)[i]), lr), bt);
+}
+
 /// The base artifact classifier recognizes artifacts based on the contents of the SDF alone.
 class BaseArtifactClassifier {
 public:
@@ -48,7 +162,7 @@ private:
 };
 
 /// The shape distance checker evaluates the exact shape distance to find additional artifacts at a significant performance cost.
-template <template <typename> class ContourCombiner, int N>
+template <template <typename> class ContourCombiner, typename T, int N>
 class ShapeDistanceChecker {
 public:
     class ArtifactClassifier : public BaseArtifactClassifier {
@@ -64,7 +178,7 @@ public:
                 float oldMSD[N], newMSD[3];
                 // Compute the color that would be currently interpolated at the artifact candidate's position.
                 Point2 sdfCoord = parent->sdfCoord+tVector;
-                interpolate(oldMSD, parent->sdf, sdfCoord);
+                interpolateTexels(oldMSD, parent->sdf, sdfCoord);
                 // Compute the color that would be interpolated at the artifact candidate's position if error correction was applied on the current texel.
                 double aWeight = (1-fabs(tVector.x))*(1-fabs(tVector.y));
                 float aPSD = median(parent->msd[0], parent->msd[1], parent->msd[2]);
@@ -74,7 +188,16 @@ public:
                 // Compute the evaluated distance (interpolated median) before and after error correction, as well as the exact shape distance.
                 float oldPSD = median(oldMSD[0], oldMSD[1], oldMSD[2]);
                 float newPSD = median(newMSD[0], newMSD[1], newMSD[2]);
-                float refPSD = float(parent->distanceMapping(parent->distanceFinder.distance(parent->shapeCoord+tVector*parent->texelSize)));
+                // The nearest edges of the texel and its neighbor at generation are likely to be near the evaluated point and allow the other edges to be skipped.
+                int seedEdges[2];
+                int seedCount = 0;
+                if (parent->nearestEdge) {
+                    seedEdges[seedCount++] = *parent->nearestEdge;
+                    int neighborEdge = parent->nearestEdge[int(direction.x)+parent->nearestEdges.width*int(direction.y)];
+                    if (neighborEdge != seedEdges[0])
+                        seedEdges[seedCount++] = neighborEdge;
+                }
+                float refPSD = float(parent->distanceMapping(parent->distanceFinder.distance(parent->shapeCoord+tVector*parent->texelSize, seedEdges, seedCount)));
                 // Compare the differences of the exact distance and the before and after distances.
                 return parent->minImproveRatio*fabsf(newPSD-refPSD) < double(fabsf(oldPSD-refPSD));
             }
@@ -86,8 +209,10 @@ public:
     };
     Point2 shapeCoord, sdfCoord;
     const float *msd;
+    /// The element of nearestEdges of the current texel, or null if there are none.
+    const int *nearestEdge;
     bool protectedFlag;
-    inline ShapeDistanceChecker(const BitmapConstRef<float, N> &sdf, const Shape &shape, const Projection &projection, DistanceMapping distanceMapping, double minImproveRatio) : distanceFinder(shape), sdf(sdf), distanceMapping(distanceMapping), minImproveRatio(minImproveRatio) {
+    inline ShapeDistanceChecker(const BitmapConstRef<T, N> &sdf, const Shape &shape, const CompiledShape *compiledShape, const Projection &projection, DistanceMapping distanceMapping, double minImproveRatio, const BitmapConstRef<int, 1> &nearestEdges) : nearestEdge(NULL), distanceFinder(shape, compiledShape, NULL), sdf(sdf), distanceMapping(distanceMapping), minImproveRatio(minImproveRatio), nearestEdges(nearestEdges) {
         texelSize = projection.unprojectVector(Vector2(1));
         if (shape.inverseYAxis)
             texelSize.y = -texelSize.y;
@@ -95,19 +220,27 @@ public:
     inline ArtifactClassifier classifier(const Vector2 &direction, double span) {
         return ArtifactClassifier(this, direction, span);
     }
+    /// Makes the subsequent evaluations independent of the previous ones.
+    inline void resetCache() {
+        distanceFinder.resetCache();
+    }
 private:
     ShapeDistanceFinder<ContourCombiner<PerpendicularDistanceSelector> > distanceFinder;
-    BitmapConstRef<float, N> sdf;
+    BitmapConstRef<T, N> sdf;
     DistanceMapping distanceMapping;
     Vector2 texelSize;
     double minImproveRatio;
+    BitmapConstRef<int, 1> nearestEdges;
 };
 
-MSDFErrorCorrection::MSDFErrorCorrection() { }
+MSDFErrorCorrection::MSDFErrorCorrection() : sectionX(0), sectionY(0), sectionHeight(0), threadCount(0) { }
 
 MSDFErrorCorrection::MSDFErrorCorrection(const BitmapRef<byte, 1> &stencil, const SDFTransformation &transformation) : stencil(stencil), transformation(transformation) {
     minDeviationRatio = ErrorCorrectionConfig::defaultMinDeviationRatio;
     minImproveRatio = ErrorCorrectionConfig::defaultMinImproveRatio;
+    sectionX = 0, sectionY = 0;
+    sectionHeight = stencil.height;
+    threadCount = 0;
     memset(stencil.pixels, 0, sizeof(byte)*stencil.width*stencil.height);
 }
 
@@ -119,6 +252,19 @@ void MSDFErrorCorrection::setMinImproveRatio(double minImproveRatio) {
     this->minImproveRatio = minImproveRatio;
 }
 
+void MSDFErrorCorrection::setThreadCount(int threadCount) {
+    this->threadCount = threadCount;
+}
+
+void MSDFErrorCorrection::setSectionOffset(int x, int y, int height) {
+    sectionX = x, sectionY = y;
+    sectionHeight = height;
+}
+
+void MSDFErrorCorrection::setNearestEdges(const BitmapConstRef<int, 1> &nearestEdges) {
+    this->nearestEdges = nearestEdges;
+}
+
 void MSDFErrorCorrection::protectCorners(const Shape &shape) {
     for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour)
         if (!contour->edges.empty()) {
@@ -132,7 +278,8 @@ void MSDFErrorCorrection::protectCorners(const Shape &shape) {
                     int l = (int) floor(p.x-.5);
                     int b = (int) floor(p.y-.5);
                     if (shape.inverseYAxis)
-                        b = stencil.height-b-2;
+                        b = sectionHeight-b-2;
+                    l -= sectionX, b -= sectionY;
                     int r = l+1;
                     int t = b+1;
                     // Check that the positions are within bounds.
@@ -188,66 +335,72 @@ static void protectExtremeChannels(byte *stencil, const float *msd, float m, int
         *stencil |= (byte) MSDFErrorCorrection::PROTECTED;
 }
 
-template <int N>
-void MSDFErrorCorrection::protectEdges(const BitmapConstRef<float, N> &sdf) {
-    float radius;
-    // Horizontal texel pairs
-    radius = float(PROTECTION_RADIUS_TOLERANCE*transformation.unprojectVector(Vector2(transformation.distanceMapping(DistanceMapping::Delta(1)), 0)).length());
-    for (int y = 0; y < sdf.height; ++y) {
-        const float *left = sdf(0, y);
-        const float *right = sdf(1, y);
-        for (int x = 0; x < sdf.width-1; ++x) {
-            float lm = median(left[0], left[1], left[2]);
-            float rm = median(right[0], right[1], right[2]);
-            if (fabsf(lm-.5f)+fabsf(rm-.5f) < radius) {
-                int mask = edgeBetweenTexels(left, right);
-                protectExtremeChannels(stencil(x, y), left, lm, mask);
-                protectExtremeChannels(stencil(x+1, y), right, rm, mask);
+/// Protects the texels of a band of rows that lie at an edge. The texel pairs that straddle the band's boundary are evaluated by both adjacent bands, each of which only marks its own texel.
+template <typename T, int N>
+class EdgeProtectionBand {
+public:
+    inline EdgeProtectionBand(const BitmapRef<byte, 1> &stencil, const BitmapConstRef<T, N> &sdf, float hRadius, float vRadius, float dRadius) : stencil(stencil), sdf(sdf), hRadius(hRadius), vRadius(vRadius), dRadius(dRadius) { }
+    void operator()(int yBegin, int yEnd) {
+        this->yBegin = yBegin, this->yEnd = yEnd;
+        int loadBegin = max(yBegin-1, 0);
+        int loadEnd = min(yEnd+1, sdf.height);
+        texels.load(sdf, loadBegin, loadEnd);
+        // Horizontal texel pairs
+        for (int y = yBegin; y < yEnd; ++y) {
+            for (int x = 0; x < sdf.width-1; ++x) {
+                float lm = texels.medianAt(x, y);
+                float rm = texels.medianAt(x+1, y);
+                if (fabsf(lm-.5f)+fabsf(rm-.5f) < hRadius)
+                    protectPair(x, y, lm, x+1, y, rm);
             }
-            left += N, right += N;
         }
-    }
-    // Vertical texel pairs
-    radius = float(PROTECTION_RADIUS_TOLERANCE*transformation.unprojectVector(Vector2(0, transformation.distanceMapping(DistanceMapping::Delta(1)))).length());
-    for (int y = 0; y < sdf.height-1; ++y) {
-        const float *bottom = sdf(0, y);
-        const float *top = sdf(0, y+1);
-        for (int x = 0; x < sdf.width; ++x) {
-            float bm = median(bottom[0], bottom[1], bottom[2]);
-            float tm = median(top[0], top[1], top[2]);
-            if (fabsf(bm-.5f)+fabsf(tm-.5f) < radius) {
-                int mask = edgeBetweenTexels(bottom, top);
-                protectExtremeChannels(stencil(x, y), bottom, bm, mask);
-                protectExtremeChannels(stencil(x, y+1), top, tm, mask);
+        // Vertical texel pairs
+        for (int y = loadBegin; y < loadEnd-1; ++y) {
+            for (int x = 0; x < sdf.width; ++x) {
+                float bm = texels.medianAt(x, y);
+                float tm = texels.medianAt(x, y+1);
+                if (fabsf(bm-.5f)+fabsf(tm-.5f) < vRadius)
+                    protectPair(x, y, bm, x, y+1, tm);
             }
-            bottom += N, top += N;
         }
-    }
-    // Diagonal texel pairs
-    radius = float(PROTECTION_RADIUS_TOLERANCE*transformation.unprojectVector(Vector2(transformation.distanceMapping(DistanceMapping::Delta(1)))).length());
-    for (int y = 0; y < sdf.height-1; ++y) {
-        const float *lb = sdf(0, y);
-        const float *rb = sdf(1, y);
-        const float *lt = sdf(0, y+1);
-        const float *rt = sdf(1, y+1);
-        for (int x = 0; x < sdf.width-1; ++x) {
-            float mlb = median(lb[0], lb[1], lb[2]);
-            float mrb = median(rb[0], rb[1], rb[2]);
-            float mlt = median(lt[0], lt[1], lt[2]);
-            float mrt = median(rt[0], rt[1], rt[2]);
-            if (fabsf(mlb-.5f)+fabsf(mrt-.5f) < radius) {
-                int mask = edgeBetweenTexels(lb, rt);
-                protectExtremeChannels(stencil(x, y), lb, mlb, mask);
-                protectExtremeChannels(stencil(x+1, y+1), rt, mrt, mask);
+        // Diagonal texel pairs
+        for (int y = loadBegin; y < loadEnd-1; ++y) {
+            for (int x = 0; x < sdf.width-1; ++x) {
+                float mlb = texels.medianAt(x, y);
+                float mrb = texels.medianAt(x+1, y);
+                float mlt = texels.medianAt(x, y+1);
+                float mrt = texels.medianAt(x+1, y+1);
+                if (fabsf(mlb-.5f)+fabsf(mrt-.5f) < dRadius)
+                    protectPair(x, y, mlb, x+1, y+1, mrt);
+                if (fabsf(mrb-.5f)+fabsf(mlt-.5f) < dRadius)
+                    protectPair(x+1, y, mrb, x, y+1, mlt);
             }
-            if (fabsf(mrb-.5f)+fabsf(mlt-.5f) < radius) {
-                int mask = edgeBetweenTexels(rb, lt);
-                protectExtremeChannels(stencil(x+1, y), rb, mrb, mask);
-                protectExtremeChannels(stencil(x, y+1), lt, mlt, mask);
-            }
-            lb += N, rb += N, lt += N, rt += N;
         }
     }
+private:
+    BitmapRef<byte, 1> stencil;
+    BitmapConstRef<T, N> sdf;
+    float hRadius, vRadius, dRadius;
+    int yBegin, yEnd;
+    TexelBand<T, N> texels;
+
+    inline void protectPair(int ax, int ay, float am, int bx, int by, float bm) {
+        const float *a = texels(ax, ay);
+        const float *b = texels(bx, by);
+        int mask = edgeBetweenTexels(a, b);
+        if (ay >= yBegin && ay < yEnd)
+            protectExtremeChannels(stencil(ax, ay), a, am, mask);
+        if (by >= yBegin && by < yEnd)
+            protectExtremeChannels(stencil(bx, by), b, bm, mask);
+    }
+};
+
+template <typename T, int N>
+void MSDFErrorCorrection::protectEdgesInner(const BitmapConstRef<T, N> &sdf) {
+    float hRadius = float(PROTECTION_RADIUS_TOLERANCE*transformation.unprojectVector(Vector2(transformation.distanceMapping(DistanceMapping::Delta(1)), 0)).length());
+    float vRadius = float(PROTECTION_RADIUS_TOLERANCE*transformation.unprojectVector(Vector2(0, transformation.distanceMapping(DistanceMapping::Delta(1)))).length());
+    float dRadius = float(PROTECTION_RADIUS_TOLERANCE*transformation.unprojectVector(Vector2(transformation.distanceMapping(DistanceMapping::Delta(1)))).length());
+    processTexelBands(sdf.height, EdgeProtectionBand<T, N>(stencil, sdf, hRadius, vRadius, dRadius), threadCount);
 }
 
 void MSDFErrorCorrection::protectAll() {
@@ -337,8 +490,7 @@ static bool hasDiagonalArtifactInner(const ArtifactClassifier &artifactClassifie
 
 /// Checks if a linear interpolation artifact will occur inbetween two horizontally or vertically adjacent texels a, b.
 template <class ArtifactClassifier>
-static bool hasLinearArtifact(const ArtifactClassifier &artifactClassifier, float am, const float *a, const float *b) {
-    float bm = median(b[0], b[1], b[2]);
+static bool hasLinearArtifact(const ArtifactClassifier &artifactClassifier, float am, float bm, const float *a, const float *b) {
     return (
         // Out of the pair, only report artifacts for the texel further from the edge to minimize side effects.
         fabsf(am-.5f) >= fabsf(bm-.5f) && (
@@ -352,8 +504,7 @@ static bool hasLinearArtifact(const ArtifactClassifier &artifactClassifier, floa
 
 /// Checks if a bilinear interpolation artifact will occur inbetween two diagonally adjacent texels a, d (with b, c forming the other diagonal).
 template <class ArtifactClassifier>
-static bool hasDiagonalArtifact(const ArtifactClassifier &artifactClassifier, float am, const float *a, const float *b, const float *c, const float *d) {
-    float dm = median(d[0], d[1], d[2]);
+static bool hasDiagonalArtifact(const ArtifactClassifier &artifactClassifier, float am, float dm, const float *a, const float *b, const float *c, const float *d) {
     // Out of the pair, only report artifacts for the texel further from the edge to minimize side effects.
     if (fabsf(am-.5f) >= fabsf(dm-.5f)) {
         float abc[3] = {
@@ -389,93 +540,321 @@ static bool hasDiagonalArtifact(const ArtifactClassifier &artifactClassifier, fl
     return false;
 }
 
-template <int N>
-void MSDFErrorCorrection::findErrors(const BitmapConstRef<float, N> &sdf) {
+template <class ArtifactClassifier>
+static bool hasLinearArtifact(const ArtifactClassifier &artifactClassifier, float am, const float *a, const float *b) {
+    return hasLinearArtifact(artifactClassifier, am, median(b[0], b[1], b[2]), a, b);
+}
+
+template <class ArtifactClassifier>
+static bool hasDiagonalArtifact(const ArtifactClassifier &artifactClassifier, float am, const float *a, const float *b, const float *c, const float *d) {
+    return hasDiagonalArtifact(artifactClassifier, am, median(d[0], d[1], d[2]), a, b, c, d);
+}
+
+/**
+ * Flags the texels of a band of rows that cause artifacts based on the contents of the SDF alone.
+ * Each pair of adjacent texels is visited once and tested only for its texel further from the edge (both if equally far), unless it has already been flagged.
+ * The pairs that straddle the band's boundary are visited by both adjacent bands, each of which only tests its own texel.
+ */
+template <typename T, int N>
+class BaseErrorFindingBand {
+public:
+    inline BaseErrorFindingBand(const BitmapRef<byte, 1> &stencil, const BitmapConstRef<T, N> &sdf, double hSpan, double vSpan, double dSpan) : stencil(stencil), sdf(sdf), hSpan(hSpan), vSpan(vSpan), dSpan(dSpan) { }
+    void operator()(int yBegin, int yEnd) {
+        this->yBegin = yBegin, this->yEnd = yEnd;
+        int loadBegin = max(yBegin-1, 0);
+        int loadEnd = min(yEnd+1, sdf.height);
+        texels.load(sdf, loadBegin, loadEnd);
+        for (int y = loadBegin; y < loadEnd; ++y) {
+            bool inBand = y >= yBegin && y < yEnd;
+            bool hasTop = y < loadEnd-1;
+            for (int x = 0; x < sdf.width; ++x) {
+                bool hasRight = x < sdf.width-1;
+                if (inBand && hasRight)
+                    checkLinearPair(x, y, x+1, y, hSpan);
+                if (hasTop) {
+                    checkLinearPair(x, y, x, y+1, vSpan);
+                    if (hasRight) {
+                        checkDiagonalPair(x, y, x+1, y, x, y+1, x+1, y+1);
+                        checkDiagonalPair(x+1, y, x, y, x+1, y+1, x, y+1);
+                    }
+                }
+            }
+        }
+    }
+private:
+    BitmapRef<byte, 1> stencil;
+    BitmapConstRef<T, N> sdf;
+    double hSpan, vSpan, dSpan;
+    int yBegin, yEnd;
+    TexelBand<T, N> texels;
+
+    /// Returns true if the texel belongs to the band and has not been flagged yet.
+    inline bool isUnflagged(int x, int y) const {
+        return y >= yBegin && y < yEnd && !(*stencil(x, y)&MSDFErrorCorrection::ERROR);
+    }
+    inline bool isProtected(int x, int y) const {
+        return (*stencil(x, y)&MSDFErrorCorrection::PROTECTED) != 0;
+    }
+    /// Checks the horizontally or vertically adjacent texels a, b for artifacts.
+    void checkLinearPair(int ax, int ay, int bx, int by, double span) {
+        float am = texels.medianAt(ax, ay);
+        float bm = texels.medianAt(bx, by);
+        const float *a = texels(ax, ay);
+        const float *b = texels(bx, by);
+        if (isUnflagged(ax, ay) && hasLinearArtifact(BaseArtifactClassifier(span, isProtected(ax, ay)), am, bm, a, b))
+            *stencil(ax, ay) |= (byte) MSDFErrorCorrection::ERROR;
+        if (isUnflagged(bx, by) && hasLinearArtifact(BaseArtifactClassifier(span, isProtected(bx, by)), bm, am, b, a))
+            *stencil(bx, by) |= (byte) MSDFErrorCorrection::ERROR;
+    }
+    /// Checks the diagonally adjacent texels a, d for artifacts, where b is horizontally and c vertically adjacent to a.
+    void checkDiagonalPair(int ax, int ay, int bx, int by, int cx, int cy, int dx, int dy) {
+        float am = texels.medianAt(ax, ay);
+        float dm = texels.medianAt(dx, dy);
+        if (isUnflagged(ax, ay) && hasDiagonalArtifact(BaseArtifactClassifier(dSpan, isProtected(ax, ay)), am, dm, texels(ax, ay), texels(bx, by), texels(cx, cy), texels(dx, dy)))
+            *stencil(ax, ay) |= (byte) MSDFErrorCorrection::ERROR;
+        if (isUnflagged(dx, dy) && hasDiagonalArtifact(BaseArtifactClassifier(dSpan, isProtected(dx, dy)), dm, am, texels(dx, dy), texels(cx, cy), texels(bx, by), texels(ax, ay)))
+            *stencil(dx, dy) |= (byte) MSDFErrorCorrection::ERROR;
+    }
+};
+
+template <typename T, int N>
+void MSDFErrorCorrection::findErrorsInner(const BitmapConstRef<T, N> &sdf) {
     // Compute the expected deltas between values of horizontally, vertically, and diagonally adjacent texels.
     double hSpan = minDeviationRatio*transformation.unprojectVector(Vector2(transformation.distanceMapping(DistanceMapping::Delta(1)), 0)).length();
     double vSpan = minDeviationRatio*transformation.unprojectVector(Vector2(0, transformation.distanceMapping(DistanceMapping::Delta(1)))).length();
     double dSpan = minDeviationRatio*transformation.unprojectVector(Vector2(transformation.distanceMapping(DistanceMapping::Delta(1)))).length();
-    // Inspect all texels.
-    for (int y = 0; y < sdf.height; ++y) {
-        for (int x = 0; x < sdf.width; ++x) {
-            const float *c = sdf(x, y);
-            float cm = median(c[0], c[1], c[2]);
-            bool protectedFlag = (*stencil(x, y)&PROTECTED) != 0;
-            const float *l = NULL, *b = NULL, *r = NULL, *t = NULL;
-            // Mark current texel c with the error flag if an artifact occurs when it's interpolated with any of its 8 neighbors.
-            *stencil(x, y) |= (byte) (ERROR*(
-                (x > 0 && ((l = sdf(x-1, y)), hasLinearArtifact(BaseArtifactClassifier(hSpan, protectedFlag), cm, c, l))) ||
-                (y > 0 && ((b = sdf(x, y-1)), hasLinearArtifact(BaseArtifactClassifier(vSpan, protectedFlag), cm, c, b))) ||
-                (x < sdf.width-1 && ((r = sdf(x+1, y)), hasLinearArtifact(BaseArtifactClassifier(hSpan, protectedFlag), cm, c, r))) ||
-                (y < sdf.height-1 && ((t = sdf(x, y+1)), hasLinearArtifact(BaseArtifactClassifier(vSpan, protectedFlag), cm, c, t))) ||
-                (x > 0 && y > 0 && hasDiagonalArtifact(BaseArtifactClassifier(dSpan, protectedFlag), cm, c, l, b, sdf(x-1, y-1))) ||
-                (x < sdf.width-1 && y > 0 && hasDiagonalArtifact(BaseArtifactClassifier(dSpan, protectedFlag), cm, c, r, b, sdf(x+1, y-1))) ||
-                (x > 0 && y < sdf.height-1 && hasDiagonalArtifact(BaseArtifactClassifier(dSpan, protectedFlag), cm, c, l, t, sdf(x-1, y+1))) ||
-                (x < sdf.width-1 && y < sdf.height-1 && hasDiagonalArtifact(BaseArtifactClassifier(dSpan, protectedFlag), cm, c, r, t, sdf(x+1, y+1)))
-            ));
+    processTexelBands(sdf.height, BaseErrorFindingBand<T, N>(stencil, sdf, hSpan, vSpan, dSpan), threadCount);
+}
+
+/// Flags texels that cause artifacts using the shape distance checker. The SDF is split into square tiles, which are processed by workers with their own checker.
+template <template <typename> class ContourCombiner, typename T, int N>
+class ShapeErrorFindingJob {
+
+public:
+    class Worker {
+    public:
+        inline explicit Worker(const ShapeErrorFindingJob &job) : job(job), shapeDistanceChecker(job.sdf, job.shape, &job.compiledShape, job.transformation, job.transformation.distanceMapping, job.minImproveRatio, job.nearestEdges) { }
+        void operator()(int tile) {
+            const BitmapRef<byte, 1> &stencil = job.stencil;
+            const BitmapConstRef<T, N> &sdf = job.sdf;
+            const SDFTransformation &transformation = job.transformation;
+            int xBegin = MSDFGEN_PARALLEL_TILE_SIZE*(tile%job.tilesX);
+            int yBegin = MSDFGEN_PARALLEL_TILE_SIZE*(job.tileYBegin+tile/job.tilesX)-job.yOffset;
+            int xEnd = min(xBegin+MSDFGEN_PARALLEL_TILE_SIZE, sdf.width);
+            int yEnd = min(yBegin+MSDFGEN_PARALLEL_TILE_SIZE, sdf.height);
+            yBegin = max(yBegin, 0);
+            bool rightToLeft = false;
+            shapeDistanceChecker.resetCache();
+            // Inspect all texels of the tile.
+            for (int y = yBegin; y < yEnd; ++y) {
+                int row = job.shape.inverseYAxis ? sdf.height-y-1 : y;
+                for (int col = xBegin; col < xEnd; ++col) {
+                    int x = rightToLeft ? xBegin+xEnd-col-1 : col;
+                    if ((*stencil(x, row)&MSDFErrorCorrection::ERROR))
+                        continue;
+                    const float *c = cLoader(sdf(x, row));
+                    int sectionRow = job.sectionY+row;
+                    shapeDistanceChecker.shapeCoord = transformation.unproject(Point2(job.sectionX+x+.5, (job.shape.inverseYAxis ? job.sectionHeight-sectionRow-1 : sectionRow)+.5));
+                    shapeDistanceChecker.sdfCoord = Point2(x+.5, row+.5);
+                    shapeDistanceChecker.msd = c;
+                    shapeDistanceChecker.nearestEdge = job.nearestEdges.pixels ? job.nearestEdges(job.sectionX+x, sectionRow) : NULL;
+                    shapeDistanceChecker.protectedFlag = (*stencil(x, row)&MSDFErrorCorrection::PROTECTED) != 0;
+                    float cm = median(c[0], c[1], c[2]);
+                    const float *l = NULL, *b = NULL, *r = NULL, *t = NULL;
+                    // Mark current texel c with the error flag if an artifact occurs when it's interpolated with any of its 8 neighbors.
+                    *stencil(x, row) |= (byte) (MSDFErrorCorrection::ERROR*(
+                        (x > 0 && ((l = lLoader(sdf(x-1, row))), hasLinearArtifact(shapeDistanceChecker.classifier(Vector2(-1, 0), job.hSpan), cm, c, l))) ||
+                        (row > 0 && ((b = bLoader(sdf(x, row-1))), hasLinearArtifact(shapeDistanceChecker.classifier(Vector2(0, -1), job.vSpan), cm, c, b))) ||
+                        (x < sdf.width-1 && ((r = rLoader(sdf(x+1, row))), hasLinearArtifact(shapeDistanceChecker.classifier(Vector2(+1, 0), job.hSpan), cm, c, r))) ||
+                        (row < sdf.height-1 && ((t = tLoader(sdf(x, row+1))), hasLinearArtifact(shapeDistanceChecker.classifier(Vector2(0, +1), job.vSpan), cm, c, t))) ||
+                        (x > 0 && row > 0 && hasDiagonalArtifact(shapeDistanceChecker.classifier(Vector2(-1, -1), job.dSpan), cm, c, l, b, dLoader(sdf(x-1, row-1)))) ||
+                        (x < sdf.width-1 && row > 0 && hasDiagonalArtifact(shapeDistanceChecker.classifier(Vector2(+1, -1), job.dSpan), cm, c, r, b, dLoader(sdf(x+1, row-1)))) ||
+                        (x > 0 && row < sdf.height-1 && hasDiagonalArtifact(shapeDistanceChecker.classifier(Vector2(-1, +1), job.dSpan), cm, c, l, t, dLoader(sdf(x-1, row+1)))) ||
+                        (x < sdf.width-1 && row < sdf.height-1 && hasDiagonalArtifact(shapeDistanceChecker.classifier(Vector2(+1, +1), job.dSpan), cm, c, r, t, dLoader(sdf(x+1, row+1))))
+                    ));
+                }
+                rightToLeft = !rightToLeft;
+            }
         }
+    private:
+        const ShapeErrorFindingJob &job;
+        ShapeDistanceChecker<ContourCombiner, T, N> shapeDistanceChecker;
+        TexelLoader<T, N> cLoader, lLoader, bLoader, rLoader, tLoader, dLoader;
+    };
+
+    inline ShapeErrorFindingJob(const BitmapRef<byte, 1> &stencil, const BitmapConstRef<T, N> &sdf, const Shape &shape, const SDFTransformation &transformation, double minDeviationRatio, double minImproveRatio, int sectionX, int sectionY, int sectionHeight, const BitmapConstRef<int, 1> &nearestEdges) :
+        stencil(stencil), sdf(sdf), shape(shape), compiledShape(shape), transformation(transformation), minImproveRatio(minImproveRatio), sectionX(sectionX), sectionY(sectionY), sectionHeight(sectionHeight), nearestEdges(nearestEdges) {
+        // Compute the expected deltas between values of horizontally, vertically, and diagonally adjacent texels.
+        hSpan = minDeviationRatio*transformation.unprojectVector(Vector2(transformation.distanceMapping(DistanceMapping::Delta(1)), 0)).length();
+        vSpan = minDeviationRatio*transformation.unprojectVector(Vector2(0, transformation.distanceMapping(DistanceMapping::Delta(1)))).length();
+        dSpan = minDeviationRatio*transformation.unprojectVector(Vector2(transformation.distanceMapping(DistanceMapping::Delta(1)))).length();
+        // The tiles are aligned with the tiles of the whole MSDF, so that the result of a section does not depend on its offset.
+        yOffset = shape.inverseYAxis ? sectionHeight-sectionY-sdf.height : sectionY;
+        tileYBegin = yOffset/MSDFGEN_PARALLEL_TILE_SIZE;
+        tilesX = (sdf.width+MSDFGEN_PARALLEL_TILE_SIZE-1)/MSDFGEN_PARALLEL_TILE_SIZE;
+        tilesY = (yOffset+sdf.height+MSDFGEN_PARALLEL_TILE_SIZE-1)/MSDFGEN_PARALLEL_TILE_SIZE-tileYBegin;
     }
+
+    inline int tileCount() const {
+        return tilesX*tilesY;
+    }
+
+private:
+    BitmapRef<byte, 1> stencil;
+    BitmapConstRef<T, N> sdf;
+    const Shape &shape;
+    /// The edges of the shape shared by the distance checkers of the workers.
+    CompiledShape compiledShape;
+    const SDFTransformation &transformation;
+    double minImproveRatio;
+    int sectionX, sectionY, sectionHeight;
+    /// The nearest edges of the texels of the whole MSDF found at generation, if known.
+    BitmapConstRef<int, 1> nearestEdges;
+    double hSpan, vSpan, dSpan;
+    /// The Y-coordinate of the first texel of the section (before inverting the Y-axis) in the whole MSDF, and the index of its first row of tiles.
+    int yOffset, tileYBegin;
+    int tilesX, tilesY;
+
+};
+
+template <template <typename> class ContourCombiner, typename T, int N>
+void MSDFErrorCorrection::findErrorsInner(const BitmapConstRef<T, N> &sdf, const Shape &shape) {
+    ShapeErrorFindingJob<ContourCombiner, T, N> job(stencil, sdf, shape, transformation, minDeviationRatio, minImproveRatio, sectionX, sectionY, sectionHeight, nearestEdges);
+    runParallelTasks(job.tileCount(), resolveThreadCount(threadCount), job);
 }
 
-template <template <typename> class ContourCombiner, int N>
-void MSDFErrorCorrection::findErrors(const BitmapConstRef<float, N> &sdf, const Shape &shape) {
-    // Compute the expected deltas between values of horizontally, vertically, and diagonally adjacent texels.
-    double hSpan = minDeviationRatio*transformation.unprojectVector(Vector2(transformation.distanceMapping(DistanceMapping::Delta(1)), 0)).length();
-    double vSpan = minDeviationRatio*transformation.unprojectVector(Vector2(0, transformation.distanceMapping(DistanceMapping::Delta(1)))).length();
-    double dSpan = minDeviationRatio*transformation.unprojectVector(Vector2(transformation.distanceMapping(DistanceMapping::Delta(1)))).length();
-#ifdef MSDFGEN_USE_OPENMP
-    #pragma omp parallel
-#endif
-    {
-        ShapeDistanceChecker<ContourCombiner, N> shapeDistanceChecker(sdf, shape, transformation, transformation.distanceMapping, minImproveRatio);
-        bool rightToLeft = false;
-        // Inspect all texels.
-#ifdef MSDFGEN_USE_OPENMP
-        #pragma omp for
-#endif
-        for (int y = 0; y < sdf.height; ++y) {
-            int row = shape.inverseYAxis ? sdf.height-y-1 : y;
-            for (int col = 0; col < sdf.width; ++col) {
-                int x = rightToLeft ? sdf.width-col-1 : col;
-                if ((*stencil(x, row)&ERROR))
-                    continue;
-                const float *c = sdf(x, row);
-                shapeDistanceChecker.shapeCoord = transformation.unproject(Point2(x+.5, y+.5));
-                shapeDistanceChecker.sdfCoord = Point2(x+.5, row+.5);
-                shapeDistanceChecker.msd = c;
-                shapeDistanceChecker.protectedFlag = (*stencil(x, row)&PROTECTED) != 0;
-                float cm = median(c[0], c[1], c[2]);
-                const float *l = NULL, *b = NULL, *r = NULL, *t = NULL;
-                // Mark current texel c with the error flag if an artifact occurs when it's interpolated with any of its 8 neighbors.
-                *stencil(x, row) |= (byte) (ERROR*(
-                    (x > 0 && ((l = sdf(x-1, row)), hasLinearArtifact(shapeDistanceChecker.classifier(Vector2(-1, 0), hSpan), cm, c, l))) ||
-                    (row > 0 && ((b = sdf(x, row-1)), hasLinearArtifact(shapeDistanceChecker.classifier(Vector2(0, -1), vSpan), cm, c, b))) ||
-                    (x < sdf.width-1 && ((r = sdf(x+1, row)), hasLinearArtifact(shapeDistanceChecker.classifier(Vector2(+1, 0), hSpan), cm, c, r))) ||
-                    (row < sdf.height-1 && ((t = sdf(x, row+1)), hasLinearArtifact(shapeDistanceChecker.classifier(Vector2(0, +1), vSpan), cm, c, t))) ||
-                    (x > 0 && row > 0 && hasDiagonalArtifact(shapeDistanceChecker.classifier(Vector2(-1, -1), dSpan), cm, c, l, b, sdf(x-1, row-1))) ||
-                    (x < sdf.width-1 && row > 0 && hasDiagonalArtifact(shapeDistanceChecker.classifier(Vector2(+1, -1), dSpan), cm, c, r, b, sdf(x+1, row-1))) ||
-                    (x > 0 && row < sdf.height-1 && hasDiagonalArtifact(shapeDistanceChecker.classifier(Vector2(-1, +1), dSpan), cm, c, l, t, sdf(x-1, row+1))) ||
-                    (x < sdf.width-1 && row < sdf.height-1 && hasDiagonalArtifact(shapeDistanceChecker.classifier(Vector2(+1, +1), dSpan), cm, c, r, t, sdf(x+1, row+1)))
-                ));
+template <typename T, int N>
+void MSDFErrorCorrection::findErrorsInner(const BitmapConstRef<T, N> &sdf, const Shape &shape, const MSDFGeneratorConfig &config) {
+    setMinDeviationRatio(config.errorCorrection.minDeviationRatio);
+    setMinImproveRatio(config.errorCorrection.minImproveRatio);
+    setThreadCount(config.threadCount);
+    switch (config.errorCorrection.mode) {
+        case ErrorCorrectionConfig::DISABLED:
+        case ErrorCorrectionConfig::INDISCRIMINATE:
+            break;
+        case ErrorCorrectionConfig::EDGE_PRIORITY:
+            protectCorners(shape);
+            protectEdgesInner(sdf);
+            break;
+        case ErrorCorrectionConfig::EDGE_ONLY:
+            protectAll();
+            break;
+    }
+    if (config.errorCorrection.distanceCheckMode == ErrorCorrectionConfig::DO_NOT_CHECK_DISTANCE || (config.errorCorrection.distanceCheckMode == ErrorCorrectionConfig::CHECK_DISTANCE_AT_EDGE && config.errorCorrection.mode != ErrorCorrectionConfig::EDGE_ONLY)) {
+        findErrorsInner(sdf);
+        if (config.errorCorrection.distanceCheckMode == ErrorCorrectionConfig::CHECK_DISTANCE_AT_EDGE)
+            protectAll();
+    }
+    if (config.errorCorrection.distanceCheckMode == ErrorCorrectionConfig::ALWAYS_CHECK_DISTANCE || config.errorCorrection.distanceCheckMode == ErrorCorrectionConfig::CHECK_DISTANCE_AT_EDGE) {
+        if (config.overlapSupport)
+            findErrorsInner<OverlappingContourCombiner>(sdf, shape);
+        else
+            findErrorsInner<SimpleContourCombiner>(sdf, shape);
+    }
+}
+
+/// Sets the color channels of the texels of a band of rows flagged with the error flag to their median.
+template <typename T, int N>
+class ErrorApplicationBand {
+public:
+    inline ErrorApplicationBand(const BitmapConstRef<byte, 1> &stencil, const BitmapRef<T, N> &sdf) : stencil(stencil), sdf(sdf) { }
+    void operator()(int yBegin, int yEnd) const {
+        int texelCount = sdf.width*(yEnd-yBegin);
+        const byte *mask = stencil(0, yBegin);
+        T *texel = sdf(0, yBegin);
+        for (int i = 0; i < texelCount; ++i) {
+            if (*mask&MSDFErrorCorrection::ERROR) {
+                // Set all color channels to the median.
+                T m = median(texel[0], texel[1], texel[2]);
+                texel[0] = m, texel[1] = m, texel[2] = m;
             }
+            ++mask;
+            texel += N;
         }
     }
+private:
+    BitmapConstRef<byte, 1> stencil;
+    BitmapRef<T, N> sdf;
+};
+
+template <typename T, int N>
+void MSDFErrorCorrection::applyInner(const BitmapRef<T, N> &sdf) const {
+    processTexelBands(sdf.height, ErrorApplicationBand<T, N>(stencil, sdf), threadCount);
+}
+
+template <int N>
+void MSDFErrorCorrection::protectEdges(const BitmapConstRef<float, N> &sdf) {
+    protectEdgesInner(sdf);
+}
+
+template <int N>
+void MSDFErrorCorrection::findErrors(const BitmapConstRef<float, N> &sdf) {
+    findErrorsInner(sdf);
+}
+
+template <template <typename> class ContourCombiner, int N>
+void MSDFErrorCorrection::findErrors(const BitmapConstRef<float, N> &sdf, const Shape &shape) {
+    findErrorsInner<ContourCombiner>(sdf, shape);
+}
+
+template <int N>
+void MSDFErrorCorrection::findErrors(const BitmapConstRef<float, N> &sdf, const Shape &shape, const MSDFGeneratorConfig &config) {
+    findErrorsInner(sdf, shape, config);
 }
 
 template <int N>
 void MSDFErrorCorrection::apply(const BitmapRef<float, N> &sdf) const {
-    int texelCount = sdf.width*sdf.height;
-    const byte *mask = stencil.pixels;
-    float *texel = sdf.pixels;
-    for (int i = 0; i < texelCount; ++i) {
-        if (*mask&ERROR) {
-            // Set all color channels to the median.
-            float m = median(texel[0], texel[1], texel[2]);
-            texel[0] = m, texel[1] = m, texel[2] = m;
-        }
-        ++mask;
-        texel += N;
-    }
+    applyInner(sdf);
+}
+
+template <int N>
+void MSDFErrorCorrection::protectEdges(const BitmapConstRef<byte, N> &sdf) {
+    protectEdgesInner(sdf);
+}
+
+template <int N>
+void MSDFErrorCorrection::findErrors(const BitmapConstRef<byte, N> &sdf) {
+    findErrorsInner(sdf);
+}
+
+template <template <typename> class ContourCombiner, int N>
+void MSDFErrorCorrection::findErrors(const BitmapConstRef<byte, N> &sdf, const Shape &shape) {
+    findErrorsInner<ContourCombiner>(sdf, shape);
+}
+
+template <int N>
+void MSDFErrorCorrection::findErrors(const BitmapConstRef<byte, N> &sdf, const Shape &shape, const MSDFGeneratorConfig &config) {
+    findErrorsInner(sdf, shape, config);
+}
+
+template <int N>
+void MSDFErrorCorrection::apply(const BitmapRef<byte, N> &sdf) const {
+    applyInner(sdf);
+}
+
+template <int N>
+void MSDFErrorCorrection::protectEdges(const BitmapConstRef<uint16, N> &sdf) {
+    protectEdgesInner(sdf);
+}
+
+template <int N>
+void MSDFErrorCorrection::findErrors(const BitmapConstRef<uint16, N> &sdf) {
+    findErrorsInner(sdf);
+}
+
+template <template <typename> class ContourCombiner, int N>
+void MSDFErrorCorrection::findErrors(const BitmapConstRef<uint16, N> &sdf, const Shape &shape) {
+    findErrorsInner<ContourCombiner>(sdf, shape);
+}
+
+template <int N>
+void MSDFErrorCorrection::findErrors(const BitmapConstRef<uint16, N> &sdf, const Shape &shape, const MSDFGeneratorConfig &config) {
+    findErrorsInner(sdf, shape, config);
+}
+
+template <int N>
+void MSDFErrorCorrection::apply(const BitmapRef<uint16, N> &sdf) const {
+    applyInner(sdf);
 }
 
 BitmapConstRef<byte, 1> MSDFErrorCorrection::getStencil() const {
@@ -490,7 +869,35 @@ template void MSDFErrorCorrection::findErrors<SimpleContourCombiner>(const Bitma
 template void MSDFErrorCorrection::findErrors<SimpleContourCombiner>(const BitmapConstRef<float, 4> &sdf, const Shape &shape);
 template void MSDFErrorCorrection::findErrors<OverlappingContourCombiner>(const BitmapConstRef<float, 3> &sdf, const Shape &shape);
 template void MSDFErrorCorrection::findErrors<OverlappingContourCombiner>(const BitmapConstRef<float, 4> &sdf, const Shape &shape);
+template void MSDFErrorCorrection::findErrors(const BitmapConstRef<float, 3> &sdf, const Shape &shape, const MSDFGeneratorConfig &config);
+template void MSDFErrorCorrection::findErrors(const BitmapConstRef<float, 4> &sdf, const Shape &shape, const MSDFGeneratorConfig &config);
 template void MSDFErrorCorrection::apply(const BitmapRef<float, 3> &sdf) const;
 template void MSDFErrorCorrection::apply(const BitmapRef<float, 4> &sdf) const;
 
+template void MSDFErrorCorrection::protectEdges(const BitmapConstRef<byte, 3> &sdf);
+template void MSDFErrorCorrection::protectEdges(const BitmapConstRef<byte, 4> &sdf);
+template void MSDFErrorCorrection::findErrors(const BitmapConstRef<byte, 3> &sdf);
+template void MSDFErrorCorrection::findErrors(const BitmapConstRef<byte, 4> &sdf);
+template void MSDFErrorCorrection::findErrors<SimpleContourCombiner>(const BitmapConstRef<byte, 3> &sdf, const Shape &shape);
+template void MSDFErrorCorrection::findErrors<SimpleContourCombiner>(const BitmapConstRef<byte, 4> &sdf, const Shape &shape);
+template void MSDFErrorCorrection::findErrors<OverlappingContourCombiner>(const BitmapConstRef<byte, 3> &sdf, const Shape &shape);
+template void MSDFErrorCorrection::findErrors<OverlappingContourCombiner>(const BitmapConstRef<byte, 4> &sdf, const Shape &shape);
+template void MSDFErrorCorrection::findErrors(const BitmapConstRef<byte, 3> &sdf, const Shape &shape, const MSDFGeneratorConfig &config);
+template void MSDFErrorCorrection::findErrors(const BitmapConstRef<byte, 4> &sdf, const Shape &shape, const MSDFGeneratorConfig &config);
+template void MSDFErrorCorrection::apply(const BitmapRef<byte, 3> &sdf) const;
+template void MSDFErrorCorrection::apply(const BitmapRef<byte, 4> &sdf) const;
+
+template void MSDFErrorCorrection::protectEdges(const BitmapConstRef<uint16, 3> &sdf);
+template void MSDFErrorCorrection::protectEdges(const BitmapConstRef<uint16, 4> &sdf);
+template void MSDFErrorCorrection::findErrors(const BitmapConstRef<uint16, 3> &sdf);
+template void MSDFErrorCorrection::findErrors(const BitmapConstRef<uint16, 4> &sdf);
+template void MSDFErrorCorrection::findErrors<SimpleContourCombiner>(const BitmapConstRef<uint16, 3> &sdf, const Shape &shape);
+template void MSDFErrorCorrection::findErrors<SimpleContourCombiner>(const BitmapConstRef<uint16, 4> &sdf, const Shape &shape);
+template void MSDFErrorCorrection::findErrors<OverlappingContourCombiner>(const BitmapConstRef<uint16, 3> &sdf, const Shape &shape);
+template void MSDFErrorCorrection::findErrors<OverlappingContourCombiner>(const BitmapConstRef<uint16, 4> &sdf, const Shape &shape);
+template void MSDFErrorCorrection::findErrors(const BitmapConstRef<uint16, 3> &sdf, const Shape &shape, const MSDFGeneratorConfig &config);
+template void MSDFErrorCorrection::findErrors(const BitmapConstRef<uint16, 4> &sdf, const Shape &shape, const MSDFGeneratorConfig &config);
+template void MSDFErrorCorrection::apply(const BitmapRef<uint16, 3> &sdf) const;
+template void MSDFErrorCorrection::apply(const BitmapRef<uint16, 4> &sdf) const;
+
 }
@@ -7,6 +7,8 @@
 
 namespace msdfgen {
 
+struct MSDFGeneratorConfig;
+
 /// Performs error correction on a computed MSDF to eliminate interpolation artifacts. This is a low-level class, you may want to use the API in msdf-error-correction.h instead.
 class MSDFErrorCorrection {
 
@@ -25,22 +27,51 @@ public:
     void setMinDeviationRatio(double minDeviationRatio);
     /// Sets the minimum ratio between the pre-correction distance error and the post-correction distance error.
     void setMinImproveRatio(double minImproveRatio);
+    /// Sets the maximum number of threads used by the shape distance check, where zero selects the default of the threading backend.
+    void setThreadCount(int threadCount);
+    /// Specifies that the stencil and the SDF only cover a section of a larger MSDF of the given height, starting at its texel (x, y).
+    void setSectionOffset(int x, int y, int height);
+    /// Sets the index of the nearest edge of each texel of the whole MSDF (see GeneratorConfig::nearestEdges), which allows the shape distance check to skip more edges without affecting the result.
+    void setNearestEdges(const BitmapConstRef<int, 1> &nearestEdges);
     /// Flags all texels that are interpolated at corners as protected.
     void protectCorners(const Shape &shape);
     /// Flags all texels that contribute to edges as protected.
     template <int N>
     void protectEdges(const BitmapConstRef<float, N> &sdf);
+    template <int N>
+    void protectEdges(const BitmapConstRef<byte, N> &sdf);
+    template <int N>
+    void protectEdges(const BitmapConstRef<uint16, N> &sdf);
     /// Flags all texels as protected.
     void protectAll();
     /// Flags texels that are expected to cause interpolation artifacts based on analysis of the SDF only.
     template <int N>
     void findErrors(const BitmapConstRef<float, N> &sdf);
+    template <int N>
+    void findErrors(const BitmapConstRef<byte, N> &sdf);
+    template <int N>
+    void findErrors(const BitmapConstRef<uint16, N> &sdf);
     /// Flags texels that are expected to cause interpolation artifacts based on analysis of the SDF and comparison with the exact shape distance.
     template <template <typename> class ContourCombiner, int N>
     void findErrors(const BitmapConstRef<float, N> &sdf, const Shape &shape);
+    template <template <typename> class ContourCombiner, int N>
+    void findErrors(const BitmapConstRef<byte, N> &sdf, const Shape &shape);
+    template <template <typename> class ContourCombiner, int N>
+    void findErrors(const BitmapConstRef<uint16, N> &sdf, const Shape &shape);
+    /// Flags protected texels and texels expected to cause interpolation artifacts according to the error correction mode and settings of config.
+    template <int N>
+    void findErrors(const BitmapConstRef<float, N> &sdf, const Shape &shape, const MSDFGeneratorConfig &config);
+    template <int N>
+    void findErrors(const BitmapConstRef<byte, N> &sdf, const Shape &shape, const MSDFGeneratorConfig &config);
+    template <int N>
+    void findErrors(const BitmapConstRef<uint16, N> &sdf, const Shape &shape, const MSDFGeneratorConfig &config);
     /// Modifies the MSDF so that all texels with the error flag are converted to single-channel.
     template <int N>
     void apply(const BitmapRef<float, N> &sdf) const;
+    template <int N>
+    void apply(const BitmapRef<byte, N> &sdf) const;
+    template <int N>
+    void apply(const BitmapRef<uint16, N> &sdf) const;
     /// Returns the stencil in its current state (see Flags).
     BitmapConstRef<byte, 1> getStencil() const;
 
@@ -49,6 +80,20 @@ private:
     SDFTransformation transformation;
     double minDeviationRatio;
     double minImproveRatio;
+    int sectionX, sectionY, sectionHeight;
+    BitmapConstRef<int, 1> nearestEdges;
+    int threadCount;
+
+    template <typename T, int N>
+    void protectEdgesInner(const BitmapConstRef<T, N> &sdf);
+    template <typename T, int N>
+    void findErrorsInner(const BitmapConstRef<T, N> &sdf);
+    template <template <typename> class ContourCombiner, typename T, int N>
+    void findErrorsInner(const BitmapConstRef<T, N> &sdf, const Shape &shape);
+    template <typename T, int N>
+    void findErrorsInner(const BitmapConstRef<T, N> &sdf, const Shape &shape, const MSDFGeneratorConfig &config);
+    template <typename T, int N>
+    void applyInner(const BitmapRef<T, N> &sdf) const;
 
 };
 
@@ -87,39 +87,46 @@ void Scanline::setIntersections(std::vector<Intersection> &&intersections) {
 }
 #endif
 
-int Scanline::moveTo(double x) const {
+int Scanline::moveTo(double x, int &index) const {
     if (intersections.empty())
         return -1;
-    int index = lastIndex;
-    if (x < intersections[index].x) {
+    int i = index;
+    if (x < intersections[i].x) {
         do {
-            if (index == 0) {
-                lastIndex = 0;
+            if (i == 0) {
+                index = 0;
                 return -1;
             }
-            --index;
-        } while (x < intersections[index].x);
+            --i;
+        } while (x < intersections[i].x);
     } else {
-        while (index < (int) intersections.size()-1 && x >= intersections[index+1].x)
-            ++index;
+        while (i < (int) intersections.size()-1 && x >= intersections[i+1].x)
+            ++i;
     }
-    lastIndex = index;
-    return index;
+    index = i;
+    return i;
 }
 
 int Scanline::countIntersections(double x) const {
-    return moveTo(x)+1;
+    return moveTo(x, lastIndex)+1;
 }
 
 int Scanline::sumIntersections(double x) const {
-    int index = moveTo(x);
-    if (index >= 0)
-        return intersections[index].direction;
-    return 0;
+    return sumIntersections(x, lastIndex);
 }
 
 bool Scanline::filled(double x, FillRule fillRule) const {
     return interpretFillRule(sumIntersections(x), fillRule);
 }
 
+int Scanline::sumIntersections(double x, int &index) const {
+    if (moveTo(x, index) >= 0)
+        return intersections[index].direction;
+    return 0;
+}
+
+bool Scanline::filled(double x, FillRule fillRule, int &index) const {
+    return interpretFillRule(sumIntersections(x, index), fillRule);
+}
+
 }
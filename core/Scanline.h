@@ -43,13 +43,16 @@ public:
     int sumIntersections(double x) const;
     /// Decides whether the scanline is filled at x based on fill rule.
     bool filled(double x, FillRule fillRule) const;
+    /// Same as sumIntersections and filled, except that the search starts at the caller's index (initially zero), which is updated, instead of the position of the previous query. These are thread-safe.
+    int sumIntersections(double x, int &index) const;
+    bool filled(double x, FillRule fillRule, int &index) const;
 
 private:
     std::vector<Intersection> intersections;
     mutable int lastIndex;
 
     void preprocess();
-    int moveTo(double x) const;
+    int moveTo(double x, int &index) const;
 
 };
 
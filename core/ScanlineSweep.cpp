@@ -0,0 +1,83 @@
+
+#include "ScanlineSweep.h"
+
+#include <cfloat>
+#include "arithmetics.hpp"
+
+namespace msdfgen {
+
+ScanlineSweep::ScanlineSweep(const Shape &shape, const Projection &projection, int height) : projection(projection), height(max(height, 1)) {
+    std::vector<Edge> unsortedEdges;
+    std::vector<int> firstRows;
+    rowEdges.resize(this->height+1, 0);
+    for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour) {
+        for (std::vector<EdgeHolder>::const_iterator edge = contour->edges.begin(); edge != contour->edges.end(); ++edge) {
+            double l = +DBL_MAX, b = +DBL_MAX, r = -DBL_MAX, t = -DBL_MAX;
+            (*edge)->bound(l, b, r, t);
+            double y0 = projection.projectY(b), y1 = projection.projectY(t);
+            double yMin = min(y0, y1), yMax = max(y0, y1);
+            Edge sweepEdge = { *edge, this->height-1 };
+            int firstRow = 0;
+            // The margin of one row on each side absorbs the rounding errors of the bounds, the projection, and the intersections
+            if (yMin <= yMax) {
+                firstRow = max(rowAt(yMin)-1, 0);
+                sweepEdge.lastRow = min(rowAt(yMax)+1, this->height-1);
+            }
+            unsortedEdges.push_back(sweepEdge);
+            firstRows.push_back(firstRow);
+            ++rowEdges[firstRow+1];
+        }
+    }
+    // Counting sort by first row
+    for (int i = 0; i < this->height; ++i)
+        rowEdges[i+1] += rowEdges[i];
+    edges.resize(unsortedEdges.size());
+    std::vector<int> nextEdge(rowEdges.begin(), rowEdges.end()-1);
+    for (int i = 0; i < (int) unsortedEdges.size(); ++i)
+        edges[nextEdge[firstRows[i]]++] = unsortedEdges[i];
+}
+
+int ScanlineSweep::rowAt(double y) const {
+    if (!(y >= 0))
+        return 0;
+    if (y >= height)
+        return height-1;
+    return int(y);
+}
+
+ScanlineSweep::Cursor::Cursor(const ScanlineSweep &sweep) : sweep(&sweep), row(-1), nextRow(0) { }
+
+void ScanlineSweep::Cursor::scanline(Scanline &line, double y) {
+    int newRow = sweep->rowAt(y);
+    if (newRow < row) {
+        activeEdges.clear();
+        nextRow = 0;
+    }
+    if (newRow != row) {
+        row = newRow;
+        for (; nextRow <= row; ++nextRow) {
+            for (int i = sweep->rowEdges[nextRow]; i < sweep->rowEdges[nextRow+1]; ++i)
+                activeEdges.push_back(i);
+        }
+        int activeCount = 0;
+        for (std::vector<int>::const_iterator edge = activeEdges.begin(); edge != activeEdges.end(); ++edge) {
+            if (sweep->edges[*edge].lastRow >= row)
+                activeEdges[activeCount++] = *edge;
+        }
+        activeEdges.resize(activeCount);
+    }
+    double shapeY = sweep->projection.unprojectY(y);
+    double x[3];
+    int dy[3];
+    intersections.clear();
+    for (std::vector<int>::const_iterator edge = activeEdges.begin(); edge != activeEdges.end(); ++edge) {
+        int n = sweep->edges[*edge].segment->scanlineIntersections(x, dy, shapeY);
+        for (int i = 0; i < n; ++i) {
+            Scanline::Intersection intersection = { x[i], dy[i] };
+            intersections.push_back(intersection);
+        }
+    }
+    line.setIntersections(intersections);
+}
+
+}
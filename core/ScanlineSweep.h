@@ -0,0 +1,57 @@
+
+#pragma once
+
+#include <vector>
+#include "Shape.h"
+#include "Projection.h"
+#include "Scanline.h"
+
+namespace msdfgen {
+
+/**
+ * Computes the scanlines of a Shape at increasing vertical pixel coordinates, which only intersect the edges whose vertical extent spans them.
+ * The edges are bucketed by the first row of pixels they (conservatively) span, and the active edges are updated from row to row by a Cursor.
+ * The scanlines are identical to Shape::scanline. The sweep itself is not modified by the cursors, so it can be shared by multiple threads, each with its own Cursor.
+ */
+class ScanlineSweep {
+
+public:
+    /// The state of a sweep, which holds the active edges and can compute the scanlines without allocating memory once they have been collected.
+    class Cursor {
+
+    public:
+        explicit Cursor(const ScanlineSweep &sweep);
+        /// Outputs the scanline that intersects the shape at the vertical pixel coordinate y. Is fastest if y is not less than in the previous call, otherwise the sweep starts over.
+        void scanline(Scanline &line, double y);
+
+    private:
+        const ScanlineSweep *sweep;
+        /// The row of the previous scanline and the next row whose edges have not been activated yet.
+        int row, nextRow;
+        std::vector<int> activeEdges;
+        std::vector<Scanline::Intersection> intersections;
+
+    };
+
+    /// Prepares the sweep of shape, which must not be modified while the sweep is in use, over height rows of pixels with the given projection.
+    ScanlineSweep(const Shape &shape, const Projection &projection, int height);
+
+private:
+    struct Edge {
+        const EdgeSegment *segment;
+        /// The last row of pixels the edge spans.
+        int lastRow;
+    };
+
+    Projection projection;
+    int height;
+    /// The edges ordered by the first row they span, where the edges of row i start at rowEdges[i].
+    std::vector<Edge> edges;
+    std::vector<int> rowEdges;
+
+    /// Returns the row of pixels that contains the vertical pixel coordinate y, clamped to the existing rows.
+    int rowAt(double y) const;
+
+};
+
+}
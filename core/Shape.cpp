@@ -5,10 +5,16 @@
 #include "arithmetics.hpp"
 
 #define DECONVERGE_OVERSHOOT 1.11111111111111111 // moves control points slightly more than necessary to account for floating-point errors
+#define CUBIC_APPROXIMATION_MAX_PARTS 64
+#define CUBIC_APPROXIMATION_SAMPLES 8
 
 namespace msdfgen {
 
-Shape::Shape() : inverseYAxis(false) { }
+static const double LARGE_VALUE = 1e240;
+
+Shape::Shape() : inverseYAxis(false) {
+    clearModifiedBounds();
+}
 
 void Shape::addContour(const Contour &contour) {
     contours.push_back(contour);
@@ -93,6 +99,89 @@ void Shape::normalize() {
     }
 }
 
+/// Computes the control points of the part of the cubic curve between parameters t0 and t1.
+static void cubicPart(const Point2 p[4], double t0, double t1, Point2 part[4]) {
+    Vector2 d0 = mix(mix(p[1]-p[0], p[2]-p[1], t0), mix(p[2]-p[1], p[3]-p[2], t0), t0);
+    Vector2 d1 = mix(mix(p[1]-p[0], p[2]-p[1], t1), mix(p[2]-p[1], p[3]-p[2], t1), t1);
+    CubicSegment curve(p[0], p[1], p[2], p[3]);
+    part[0] = curve.point(t0);
+    part[1] = part[0]+(t1-t0)*d0;
+    part[3] = curve.point(t1);
+    part[2] = part[3]-(t1-t0)*d1;
+}
+
+/// Approximates the cubic curve by a quadratic curve whose control point is the intersection of the cubic curve's end tangents if possible. Returns false if the end directions had to be altered.
+static bool approximateCubicPart(const CubicSegment &part, Point2 &control) {
+    const Point2 *p = part.p;
+    Vector2 aDir = part.direction(0), bDir = part.direction(1);
+    double denominator = crossProduct(aDir, bDir);
+    if (fabs(denominator) > MSDFGEN_CORNER_DOT_EPSILON*aDir.length()*bDir.length()) {
+        double s = crossProduct(p[3]-p[0], bDir)/denominator;
+        double u = crossProduct(aDir, p[3]-p[0])/denominator;
+        if (s > 0 && u > 0) {
+            control = p[0]+s*aDir;
+            return true;
+        }
+    }
+    control = .25*(3*(p[1]+p[2])-p[0]-p[3]);
+    // A straight part keeps its direction
+    return !crossProduct(control-p[0], aDir) && !crossProduct(p[3]-control, bDir);
+}
+
+/// Estimates the distance between the two curves by sampling points on each of them.
+static double approximationError(const EdgeSegment &curve, const EdgeSegment &approximation) {
+    double error = 0, param;
+    for (int i = 1; i < CUBIC_APPROXIMATION_SAMPLES; ++i) {
+        double t = double(i)/CUBIC_APPROXIMATION_SAMPLES;
+        error = max(error, fabs(approximation.signedDistance(curve.point(t), param).distance));
+        error = max(error, fabs(curve.signedDistance(approximation.point(t), param).distance));
+    }
+    return error;
+}
+
+/// Replaces the cubic curve with the smallest number of quadratic curves (of equal parameter spans) that approximate it within tolerance and appends them to edges.
+static void approximateCubic(const CubicSegment &cubic, double tolerance, std::vector<EdgeHolder> &edges) {
+    std::vector<EdgeHolder> parts;
+    for (int n = 1; n <= CUBIC_APPROXIMATION_MAX_PARTS; ++n) {
+        parts.clear();
+        bool accepted = true;
+        for (int i = 0; i < n && accepted; ++i) {
+            Point2 p[4];
+            cubicPart(cubic.p, double(i)/n, double(i+1)/n, p);
+            CubicSegment part(p[0], p[1], p[2], p[3]);
+            Point2 control;
+            // The directions at the ends of the original curve must be preserved to keep the corners of the contour the same
+            if (!approximateCubicPart(part, control) && (i == 0 || i == n-1))
+                accepted = false;
+            parts.push_back(EdgeHolder(p[0], control, p[3], cubic.color));
+            if (approximationError(part, *parts.back()) > tolerance)
+                accepted = false;
+        }
+        if (accepted)
+            break;
+    }
+    // The endpoints must match exactly
+    parts.front()->moveStartPoint(cubic.p[0]);
+    parts.back()->moveEndPoint(cubic.p[3]);
+    edges.insert(edges.end(), parts.begin(), parts.end());
+}
+
+void Shape::approximateCubics(double tolerance) {
+    for (std::vector<Contour>::iterator contour = contours.begin(); contour != contours.end(); ++contour) {
+        std::vector<EdgeHolder> edges;
+        edges.reserve(contour->edges.size());
+        for (std::vector<EdgeHolder>::iterator edge = contour->edges.begin(); edge != contour->edges.end(); ++edge) {
+            if ((*edge)->type() == (int) CubicSegment::EDGE_TYPE)
+                approximateCubic(*static_cast<const CubicSegment *>(&**edge), tolerance, edges);
+            else {
+                edges.push_back(EdgeHolder());
+                EdgeHolder::swap(edges.back(), *edge);
+            }
+        }
+        contour->edges.swap(edges);
+    }
+}
+
 void Shape::bound(double &l, double &b, double &r, double &t) const {
     for (std::vector<Contour>::const_iterator contour = contours.begin(); contour != contours.end(); ++contour)
         contour->bound(l, b, r, t);
@@ -104,7 +193,6 @@ void Shape::boundMiters(double &l, double &b, double &r, double &t, double borde
 }
 
 Shape::Bounds Shape::getBounds(double border, double miterLimit, int polarity) const {
-    static const double LARGE_VALUE = 1e240;
     Shape::Bounds bounds = { +LARGE_VALUE, +LARGE_VALUE, -LARGE_VALUE, -LARGE_VALUE };
     bound(bounds.l, bounds.b, bounds.r, bounds.t);
     if (border > 0) {
@@ -116,6 +204,19 @@ Shape::Bounds Shape::getBounds(double border, double miterLimit, int polarity) c
     return bounds;
 }
 
+void Shape::markModified(const EdgeSegment *edge) {
+    edge->bound(modifiedBounds.l, modifiedBounds.b, modifiedBounds.r, modifiedBounds.t);
+}
+
+void Shape::markModified(const Contour &contour) {
+    contour.bound(modifiedBounds.l, modifiedBounds.b, modifiedBounds.r, modifiedBounds.t);
+}
+
+void Shape::clearModifiedBounds() {
+    modifiedBounds.l = +LARGE_VALUE, modifiedBounds.b = +LARGE_VALUE;
+    modifiedBounds.r = -LARGE_VALUE, modifiedBounds.t = -LARGE_VALUE;
+}
+
 void Shape::scanline(Scanline &line, double y) const {
     std::vector<Scanline::Intersection> intersections;
     double x[3];
@@ -22,6 +22,8 @@ public:
     std::vector<Contour> contours;
     /// Specifies whether the shape uses bottom-to-top (false) or top-to-bottom (true) Y coordinates.
     bool inverseYAxis;
+    /// The bounding box of the edges marked as modified since the last call to clearModifiedBounds (see markModified). Empty (l > r) if there are none.
+    Bounds modifiedBounds;
 
     Shape();
     /// Adds a contour.
@@ -33,6 +35,9 @@ public:
     Contour &addContour();
     /// Normalizes the shape geometry for distance field generation.
     void normalize();
+    /// Replaces each cubic curve with quadratic curves of the same color that deviate from it by approximately at most tolerance (in shape units), which are faster to compute distances to.
+    /// The directions at the endpoints of each cubic curve are preserved, so corners and edge coloring are unaffected, except that the quadratic curves are colored as separate edges if colors are assigned afterwards.
+    void approximateCubics(double tolerance);
     /// Performs basic checks to determine if the object represents a valid shape.
     bool validate() const;
     /// Adjusts the bounding box to fit the shape.
@@ -43,6 +48,12 @@ public:
     Bounds getBounds(double border = 0, double miterLimit = 0, int polarity = 0) const;
     /// Outputs the scanline that intersects the shape at y.
     void scanline(Scanline &line, double y) const;
+    /// Includes the edge in modifiedBounds. To track an edit, an edge must be marked before and after it is modified, after it is added, and before it is removed. The colors of the other edges must stay the same.
+    void markModified(const EdgeSegment *edge);
+    /// Includes all edges of the contour in modifiedBounds.
+    void markModified(const Contour &contour);
+    /// Empties modifiedBounds, e.g. after the affected region of the distance field has been regenerated.
+    void clearModifiedBounds();
     /// Returns the total number of edge segments
     int edgeCount() const;
     /// Assumes its contours are unoriented (even-odd fill rule). Attempts to orient them to conform to the non-zero winding rule.
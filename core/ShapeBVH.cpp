@@ -0,0 +1,76 @@
+#include "ShapeBVH.h"
+
+#include <cmath>
+
+namespace msdfgen {
+
+double ShapeBVH::Node::distanceBound(const Point2 &p) const {
+    double dx = 0, dy = 0;
+    if (p.x < l)
+        dx = l-p.x;
+    else if (p.x > r)
+        dx = p.x-r;
+    if (p.y < b)
+        dy = b-p.y;
+    else if (p.y > t)
+        dy = p.y-t;
+    return sqrt(dx*dx+dy*dy);
+}
+
+ShapeBVH::ShapeBVH() { }
+
+ShapeBVH::ShapeBVH(const Shape &shape) {
+    build(shape);
+}
+
+void ShapeBVH::build(const Shape &shape) {
+    nodes.clear();
+    roots.clear();
+    roots.reserve(shape.contours.size());
+    for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour) {
+        if (!contour->edges.empty()) {
+            roots.push_back((int) nodes.size());
+            nodes.resize(nodes.size()+1);
+            buildNode(roots.back(), *contour, 0, (int) contour->edges.size());
+        } else
+            roots.push_back(-1);
+    }
+}
+
+void ShapeBVH::buildNode(int nodeIndex, const Contour &contour, int begin, int end) {
+    int n = (int) contour.edges.size();
+    Node node;
+    node.l = +1e240, node.b = +1e240;
+    node.r = -1e240, node.t = -1e240;
+    node.children = -1;
+    node.begin = begin;
+    node.end = end;
+    node.color = 0;
+    for (int i = begin; i < end; ++i) {
+        const EdgeSegment *edge = contour.edges[(i+n-1)%n];
+        edge->bound(node.l, node.b, node.r, node.t);
+        node.color |= edge->color;
+    }
+    if (end-begin > MSDFGEN_BVH_LEAF_SIZE) {
+        int mid = begin+(end-begin)/2;
+        node.children = (int) nodes.size();
+        nodes.resize(nodes.size()+2);
+        buildNode(node.children, contour, begin, mid);
+        buildNode(node.children+1, contour, mid, end);
+    }
+    nodes[nodeIndex] = node;
+}
+
+int ShapeBVH::contourRoot(int contourIndex) const {
+    return roots[contourIndex];
+}
+
+int ShapeBVH::nodeCount() const {
+    return (int) nodes.size();
+}
+
+const ShapeBVH::Node &ShapeBVH::operator[](int nodeIndex) const {
+    return nodes[nodeIndex];
+}
+
+}
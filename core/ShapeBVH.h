@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include "Vector2.hpp"
+#include "Shape.h"
+
+namespace msdfgen {
+
+/// Maximum number of edges in a leaf node of ShapeBVH.
+#define MSDFGEN_BVH_LEAF_SIZE 4
+
+/**
+ * A bounding volume hierarchy over the edges of each contour of a Shape.
+ * Each node covers a contiguous range of the contour's edge slots, in the order ShapeDistanceFinder visits them,
+ * so that traversing the tree from the first child to the second visits the edges in the same order as a linear scan.
+ * Edge slot i of a contour with n edges refers to edge (i+n-1)%n, with (i+n-2)%n and i as its neighbors.
+ */
+class ShapeBVH {
+
+public:
+    struct Node {
+        /// The bounding box of the node's edges.
+        double l, b, r, t;
+        /// Index of the first of the two consecutive child nodes, or -1 for a leaf node.
+        int children;
+        /// The range of the contour's edge slots covered by the node.
+        int begin, end;
+        /// The union of the colors of the node's edges.
+        int color;
+
+        /// Returns a lower bound of the distance between p and any of the node's edges.
+        double distanceBound(const Point2 &p) const;
+    };
+
+    ShapeBVH();
+    explicit ShapeBVH(const Shape &shape);
+    /// Builds the hierarchy for shape, which must not be modified while the hierarchy is in use.
+    void build(const Shape &shape);
+    /// Returns the index of the root node of the specified contour, or -1 if the contour has no edges.
+    int contourRoot(int contourIndex) const;
+    /// Returns the total number of nodes.
+    int nodeCount() const;
+    const Node &operator[](int nodeIndex) const;
+
+private:
+    std::vector<Node> nodes;
+    std::vector<int> roots;
+
+    void buildNode(int nodeIndex, const Contour &contour, int begin, int end);
+
+};
+
+}
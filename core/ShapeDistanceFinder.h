@@ -5,6 +5,9 @@
 #include "Vector2.hpp"
 #include "edge-selectors.h"
 #include "contour-combiners.h"
+#include "ShapeBVH.h"
+#include "CompiledShape.h"
+#include "generator-config.h"
 
 namespace msdfgen {
 
@@ -17,16 +20,49 @@ public:
 
     // Passed shape object must persist until the distance finder is destroyed!
     explicit ShapeDistanceFinder(const Shape &shape);
+    /// If bvh (built for the same shape) is not null, it is used to skip groups of edges that cannot affect the result. The output is identical.
+    ShapeDistanceFinder(const Shape &shape, const ShapeBVH *bvh);
+    /// Uses compiledShape (built from the same shape) for the queries instead of building its own.
+    ShapeDistanceFinder(const Shape &shape, const CompiledShape *compiledShape, const ShapeBVH *bvh);
     /// Finds the distance from origin. Not thread-safe! Is fastest when subsequent queries are close together.
     DistanceType distance(const Point2 &origin);
+    /// Same as above, but first limits the distance of each contour by the distances of those of the seedCount edges (numbered as in CompiledShape) that belong to it, which allows more edges to be skipped if they are near origin. The result is unchanged.
+    DistanceType distance(const Point2 &origin, const int *seedEdges, int seedCount);
+    /// Returns the index of the nearest edge among the edges evaluated by the last query of a single origin, or -1 if none were evaluated.
+    int nearestEdge() const;
+    /// Returns a lower bound of the distance between the origin of the last query of a single origin and the nearest edge of the shape.
+    /// Unlike the distance selected by an overlapping contour combiner, which may be that of a contour farther than the nearest edge, it cannot decrease faster than the origin moves.
+    double edgeDistanceBound() const;
+    /// Discards the results of previous queries cached to speed up subsequent ones, after which the results of queries do not depend on the order in which they were made.
+    void resetCache();
+    /// Returns the statistics of the queries since construction or the last call to resetStatistics.
+    const EdgeCacheStatistics &getStatistics() const;
+    void resetStatistics();
 
     /// Finds the distance between shape and origin. Does not allocate result cache used to optimize performance of multiple queries.
     static DistanceType oneShotDistance(const Shape &shape, const Point2 &origin);
 
 private:
+    typedef typename ContourCombiner::EdgeSelectorType EdgeSelector;
+    typedef typename EdgeSelector::ScalarType ScalarType;
+
     const Shape &shape;
+    CompiledShape ownCompiledShape;
+    const CompiledShape *compiledShape;
+    const ShapeBVH *bvh;
     ContourCombiner contourCombiner;
-    std::vector<typename ContourCombiner::EdgeSelectorType::EdgeCache> shapeEdgeCache;
+    std::vector<typename EdgeSelector::EdgeCache> shapeEdgeCache;
+    std::vector<typename EdgeSelector::GroupCache> shapeGroupCache;
+    EdgeCacheStatistics statistics;
+    int nearestEdgeIndex;
+    ScalarType nearestEdgeDistance;
+    /// The minimum lower bound of the distances of the contours skipped by the last query.
+    double skippedContourDistance;
+
+    /// Adds the edges of a contour to the edge selector. The edge cache is that of the whole shape.
+    void addContour(EdgeSelector &edgeSelector, const BasicVector2<ScalarType> &origin, int contourIndex, typename EdgeSelector::EdgeCache *edgeCache);
+    bool addEdge(EdgeSelector &edgeSelector, typename EdgeSelector::EdgeCache &cache, const BasicVector2<ScalarType> &origin, int edge);
+    void addEdgeGroup(EdgeSelector &edgeSelector, const BasicVector2<ScalarType> &origin, int contourBegin, int contourEnd, typename EdgeSelector::EdgeCache *contourEdgeCache, int nodeIndex);
 
 };
 
@@ -1,31 +1,72 @@
 
 #include "ShapeDistanceFinder.h"
 
+#include <cfloat>
+#include <algorithm>
+
 namespace msdfgen {
 
 template <class ContourCombiner>
-ShapeDistanceFinder<ContourCombiner>::ShapeDistanceFinder(const Shape &shape) : shape(shape), contourCombiner(shape), shapeEdgeCache(shape.edgeCount()) { }
+ShapeDistanceFinder<ContourCombiner>::ShapeDistanceFinder(const Shape &shape) : shape(shape), ownCompiledShape(shape), compiledShape(&ownCompiledShape), bvh(NULL), contourCombiner(shape), shapeEdgeCache(shape.edgeCount()), nearestEdgeIndex(-1), nearestEdgeDistance(0), skippedContourDistance(DBL_MAX) { }
+
+template <class ContourCombiner>
+ShapeDistanceFinder<ContourCombiner>::ShapeDistanceFinder(const Shape &shape, const ShapeBVH *bvh) : shape(shape), ownCompiledShape(shape), compiledShape(&ownCompiledShape), bvh(bvh), contourCombiner(shape), shapeEdgeCache(shape.edgeCount()), shapeGroupCache(bvh ? bvh->nodeCount() : 0), nearestEdgeIndex(-1), nearestEdgeDistance(0), skippedContourDistance(DBL_MAX) { }
+
+template <class ContourCombiner>
+ShapeDistanceFinder<ContourCombiner>::ShapeDistanceFinder(const Shape &shape, const CompiledShape *compiledShape, const ShapeBVH *bvh) : shape(shape), compiledShape(compiledShape), bvh(bvh), contourCombiner(shape), shapeEdgeCache(shape.edgeCount()), shapeGroupCache(bvh ? bvh->nodeCount() : 0), nearestEdgeIndex(-1), nearestEdgeDistance(0), skippedContourDistance(DBL_MAX) { }
 
 template <class ContourCombiner>
 typename ShapeDistanceFinder<ContourCombiner>::DistanceType ShapeDistanceFinder<ContourCombiner>::distance(const Point2 &origin) {
+    return distance(origin, NULL, 0);
+}
+
+template <class ContourCombiner>
+typename ShapeDistanceFinder<ContourCombiner>::DistanceType ShapeDistanceFinder<ContourCombiner>::distance(const Point2 &origin, const int *seedEdges, int seedCount) {
     contourCombiner.reset(origin);
+    ++statistics.queryCount;
 #ifdef MSDFGEN_USE_CPP11
-    typename ContourCombiner::EdgeSelectorType::EdgeCache *edgeCache = shapeEdgeCache.data();
+    typename EdgeSelector::EdgeCache *edgeCache = shapeEdgeCache.data();
 #else
-    typename ContourCombiner::EdgeSelectorType::EdgeCache *edgeCache = shapeEdgeCache.empty() ? NULL : &shapeEdgeCache[0];
+    typename EdgeSelector::EdgeCache *edgeCache = shapeEdgeCache.empty() ? NULL : &shapeEdgeCache[0];
 #endif
+    BasicVector2<ScalarType> p(origin);
+    nearestEdgeIndex = -1;
+    skippedContourDistance = DBL_MAX;
 
-    for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour) {
-        if (!contour->edges.empty()) {
-            typename ContourCombiner::EdgeSelectorType &edgeSelector = contourCombiner.edgeSelector(int(contour-shape.contours.begin()));
+    // The distance of each seed edge is an upper bound of the distance of its contour, which is then selected among the edges nearer than that
+    for (int i = 0; i < seedCount; ++i) {
+        int edge = seedEdges[i];
+        if (edge >= 0 && edge < compiledShape->edgeCount()) {
+            ScalarType param;
+            BasicSignedDistance<ScalarType> distance = compiledShape->signedDistance(edge, p, param);
+            contourCombiner.edgeSelector(compiledShape->edgeContour(edge)).boundDistance(compiledShape->edge(edge), distance.distance);
+            ++statistics.evaluatedEdgeCount;
+            if (nearestEdgeIndex < 0 || fabs(distance.distance) < nearestEdgeDistance) {
+                nearestEdgeIndex = edge;
+                nearestEdgeDistance = fabs(distance.distance);
+            }
+        }
+    }
 
-            const EdgeSegment *prevEdge = contour->edges.size() >= 2 ? *(contour->edges.end()-2) : *contour->edges.begin();
-            const EdgeSegment *curEdge = contour->edges.back();
-            for (std::vector<EdgeHolder>::const_iterator edge = contour->edges.begin(); edge != contour->edges.end(); ++edge) {
-                const EdgeSegment *nextEdge = *edge;
-                edgeSelector.addEdge(*edgeCache++, prevEdge, curEdge, nextEdge);
-                prevEdge = curEdge;
-                curEdge = nextEdge;
+    // Contours deferred by the combiner are evaluated after all others, and only if they can still affect the distance
+    bool deferred = false;
+    for (int i = 0; i < compiledShape->contourCount(); ++i) {
+        if (compiledShape->contourBegin(i) < compiledShape->contourEnd(i)) {
+            if (contourCombiner.deferContour(i))
+                deferred = true;
+            else
+                addContour(contourCombiner.edgeSelector(i), p, i, edgeCache);
+        }
+    }
+    if (deferred) {
+        for (int i = 0; i < compiledShape->contourCount(); ++i) {
+            if (compiledShape->contourBegin(i) < compiledShape->contourEnd(i) && contourCombiner.isContourDeferred(i)) {
+                if (contourCombiner.isContourRelevant(i))
+                    addContour(contourCombiner.edgeSelector(i), p, i, edgeCache);
+                else {
+                    statistics.skippedEdgeCount += compiledShape->contourEnd(i)-compiledShape->contourBegin(i);
+                    skippedContourDistance = min(skippedContourDistance, contourCombiner.deferredContourDistance(i));
+                }
             }
         }
     }
@@ -33,6 +74,94 @@ typename ShapeDistanceFinder<ContourCombiner>::DistanceType ShapeDistanceFinder<
     return contourCombiner.distance();
 }
 
+template <class ContourCombiner>
+void ShapeDistanceFinder<ContourCombiner>::addContour(EdgeSelector &edgeSelector, const BasicVector2<ScalarType> &origin, int contourIndex, typename EdgeSelector::EdgeCache *edgeCache) {
+    int begin = compiledShape->contourBegin(contourIndex), end = compiledShape->contourEnd(contourIndex);
+    if (bvh) {
+        addEdgeGroup(edgeSelector, origin, begin, end, edgeCache+begin, bvh->contourRoot(contourIndex));
+        return;
+    }
+    edgeCache += begin;
+    int curEdge = end-1;
+    for (int nextEdge = begin; nextEdge < end; ++nextEdge) {
+        if (addEdge(edgeSelector, *edgeCache++, origin, curEdge))
+            ++statistics.evaluatedEdgeCount;
+        else
+            ++statistics.skippedEdgeCount;
+        curEdge = nextEdge;
+    }
+}
+
+template <class ContourCombiner>
+bool ShapeDistanceFinder<ContourCombiner>::addEdge(EdgeSelector &edgeSelector, typename EdgeSelector::EdgeCache &cache, const BasicVector2<ScalarType> &origin, int edge) {
+    // Equivalent to EdgeSelector::addEdge without the distance, except that the distance and the edge geometry are computed from precomputed data without a virtual call.
+    const EdgeSegment *edgeSegment = compiledShape->edge(edge);
+    if (!edgeSelector.isEdgeRelevant(cache, edgeSegment))
+        return false;
+    ScalarType param;
+    BasicSignedDistance<ScalarType> distance = compiledShape->signedDistance(edge, origin, param);
+    edgeSelector.addEdge(cache, edgeSegment, compiledShape->template geometry<ScalarType>(edge), distance, param);
+    if (nearestEdgeIndex < 0 || fabs(distance.distance) < nearestEdgeDistance) {
+        nearestEdgeIndex = edge;
+        nearestEdgeDistance = fabs(distance.distance);
+    }
+    return true;
+}
+
+template <class ContourCombiner>
+void ShapeDistanceFinder<ContourCombiner>::addEdgeGroup(EdgeSelector &edgeSelector, const BasicVector2<ScalarType> &origin, int contourBegin, int contourEnd, typename EdgeSelector::EdgeCache *contourEdgeCache, int nodeIndex) {
+    const ShapeBVH::Node &node = (*bvh)[nodeIndex];
+    typename EdgeSelector::GroupCache &groupCache = shapeGroupCache[nodeIndex];
+    if (!edgeSelector.isGroupRelevant(groupCache, node)) {
+        statistics.skippedEdgeCount += node.end-node.begin;
+        return;
+    }
+    if (node.children >= 0) {
+        // Children are visited in edge order so that ties between equidistant edges resolve the same way as in the linear scan
+        addEdgeGroup(edgeSelector, origin, contourBegin, contourEnd, contourEdgeCache, node.children);
+        addEdgeGroup(edgeSelector, origin, contourBegin, contourEnd, contourEdgeCache, node.children+1);
+        edgeSelector.updateGroupCache(groupCache, &shapeGroupCache[node.children], 2);
+    } else {
+        int n = contourEnd-contourBegin;
+        for (int i = node.begin; i < node.end; ++i) {
+            if (addEdge(edgeSelector, contourEdgeCache[i], origin, contourBegin+(i+n-1)%n))
+                ++statistics.evaluatedEdgeCount;
+            else
+                ++statistics.skippedEdgeCount;
+        }
+        edgeSelector.updateGroupCache(groupCache, contourEdgeCache+node.begin, node.end-node.begin);
+    }
+}
+
+template <class ContourCombiner>
+int ShapeDistanceFinder<ContourCombiner>::nearestEdge() const {
+    return nearestEdgeIndex;
+}
+
+template <class ContourCombiner>
+double ShapeDistanceFinder<ContourCombiner>::edgeDistanceBound() const {
+    // Edges of the evaluated contours are only skipped if they are farther than the nearest evaluated edge of their contour.
+    if (nearestEdgeIndex < 0)
+        return skippedContourDistance;
+    return min(double(nearestEdgeDistance), skippedContourDistance);
+}
+
+template <class ContourCombiner>
+void ShapeDistanceFinder<ContourCombiner>::resetCache() {
+    std::fill(shapeEdgeCache.begin(), shapeEdgeCache.end(), typename EdgeSelector::EdgeCache());
+    std::fill(shapeGroupCache.begin(), shapeGroupCache.end(), typename EdgeSelector::GroupCache());
+}
+
+template <class ContourCombiner>
+const EdgeCacheStatistics &ShapeDistanceFinder<ContourCombiner>::getStatistics() const {
+    return statistics;
+}
+
+template <class ContourCombiner>
+void ShapeDistanceFinder<ContourCombiner>::resetStatistics() {
+    statistics = EdgeCacheStatistics();
+}
+
 template <class ContourCombiner>
 typename ShapeDistanceFinder<ContourCombiner>::DistanceType ShapeDistanceFinder<ContourCombiner>::oneShotDistance(const Shape &shape, const Point2 &origin) {
     ContourCombiner contourCombiner(shape);
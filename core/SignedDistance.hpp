@@ -3,36 +3,46 @@
 
 #include <cmath>
 #include <cfloat>
+#include <limits>
 #include "base.h"
 
 namespace msdfgen {
 
 /// Represents a signed distance and alignment, which together can be compared to uniquely determine the closest edge segment.
-class SignedDistance {
+template <typename T>
+class BasicSignedDistance {
 
 public:
-    double distance;
-    double dot;
+    T distance;
+    T dot;
 
-    inline SignedDistance() : distance(-DBL_MAX), dot(0) { }
-    inline SignedDistance(double dist, double d) : distance(dist), dot(d) { }
+    inline BasicSignedDistance() : distance(-std::numeric_limits<T>::max()), dot(0) { }
+    inline BasicSignedDistance(T dist, T d) : distance(dist), dot(d) { }
 
-};
+    /// Converts a signed distance of another scalar type.
+    template <typename S>
+    inline explicit BasicSignedDistance(const BasicSignedDistance<S> &other) : distance(T(other.distance)), dot(T(other.dot)) { }
 
-inline bool operator<(const SignedDistance a, const SignedDistance b) {
-    return fabs(a.distance) < fabs(b.distance) || (fabs(a.distance) == fabs(b.distance) && a.dot < b.dot);
-}
+    friend inline bool operator<(const BasicSignedDistance a, const BasicSignedDistance b) {
+        return fabs(a.distance) < fabs(b.distance) || (fabs(a.distance) == fabs(b.distance) && a.dot < b.dot);
+    }
 
-inline bool operator>(const SignedDistance a, const SignedDistance b) {
-    return fabs(a.distance) > fabs(b.distance) || (fabs(a.distance) == fabs(b.distance) && a.dot > b.dot);
-}
+    friend inline bool operator>(const BasicSignedDistance a, const BasicSignedDistance b) {
+        return fabs(a.distance) > fabs(b.distance) || (fabs(a.distance) == fabs(b.distance) && a.dot > b.dot);
+    }
 
-inline bool operator<=(const SignedDistance a, const SignedDistance b) {
-    return fabs(a.distance) < fabs(b.distance) || (fabs(a.distance) == fabs(b.distance) && a.dot <= b.dot);
-}
+    friend inline bool operator<=(const BasicSignedDistance a, const BasicSignedDistance b) {
+        return fabs(a.distance) < fabs(b.distance) || (fabs(a.distance) == fabs(b.distance) && a.dot <= b.dot);
+    }
 
-inline bool operator>=(const SignedDistance a, const SignedDistance b) {
-    return fabs(a.distance) > fabs(b.distance) || (fabs(a.distance) == fabs(b.distance) && a.dot >= b.dot);
-}
+    friend inline bool operator>=(const BasicSignedDistance a, const BasicSignedDistance b) {
+        return fabs(a.distance) > fabs(b.distance) || (fabs(a.distance) == fabs(b.distance) && a.dot >= b.dot);
+    }
+
+};
+
+typedef BasicSignedDistance<double> SignedDistance;
+/// A signed distance with single precision, used by the single-precision distance field generator.
+typedef BasicSignedDistance<float> FloatSignedDistance;
 
 }
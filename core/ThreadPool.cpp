@@ -0,0 +1,130 @@
+
+#include "ThreadPool.h"
+
+namespace msdfgen {
+
+int resolveThreadCount(int threadCount) {
+#if defined(MSDFGEN_USE_THREADS)
+    if (threadCount > 0)
+        return threadCount;
+    int hardwareThreads = int(std::thread::hardware_concurrency());
+    return hardwareThreads > 0 ? hardwareThreads : 1;
+#elif defined(MSDFGEN_USE_OPENMP)
+    if (threadCount > 0)
+        return threadCount;
+    return omp_get_max_threads();
+#else
+    (void) threadCount;
+    return 1;
+#endif
+}
+
+#ifdef MSDFGEN_USE_THREADS
+
+ThreadPool &ThreadPool::shared() {
+    static ThreadPool pool(resolveThreadCount(0)-1);
+    return pool;
+}
+
+ThreadPool::ThreadPool(int workerCount) : terminating(false) {
+    for (int i = 0; i < workerCount; ++i)
+        workers.push_back(std::thread(&ThreadPool::workerMain, this));
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        terminating = true;
+    }
+    jobsAvailable.notify_all();
+    for (std::vector<std::thread>::iterator worker = workers.begin(); worker != workers.end(); ++worker)
+        worker->join();
+}
+
+int ThreadPool::getWorkerCount() const {
+    return int(workers.size());
+}
+
+void ThreadPool::run(int jobCount, const std::function<void(int)> &job) {
+    if (jobCount <= 0)
+        return;
+    if (jobCount == 1 || workers.empty()) {
+        for (int i = 0; i < jobCount; ++i)
+            job(i);
+        return;
+    }
+    Batch batch;
+    batch.job = &job;
+    batch.jobCount = jobCount;
+    batch.nextJob = 0;
+    batch.unfinishedJobs = jobCount;
+    std::unique_lock<std::mutex> lock(mutex);
+    batches.push_back(&batch);
+    jobsAvailable.notify_all();
+    // Help with the jobs of this batch (or of batches queued before it) until all of them have been started.
+    while (batch.nextJob < batch.jobCount)
+        executeJob(lock);
+    while (batch.unfinishedJobs > 0)
+        batchFinished.wait(lock);
+}
+
+void ThreadPool::workerMain() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        while (!terminating && batches.empty())
+            jobsAvailable.wait(lock);
+        if (terminating)
+            return;
+        executeJob(lock);
+    }
+}
+
+void ThreadPool::executeJob(std::unique_lock<std::mutex> &lock) {
+    Batch *batch = batches.front();
+    int index = batch->nextJob++;
+    if (batch->nextJob == batch->jobCount)
+        batches.pop_front();
+    lock.unlock();
+    (*batch->job)(index);
+    lock.lock();
+    if (!--batch->unfinishedJobs)
+        batchFinished.notify_all();
+}
+
+WorkStealingScheduler::WorkStealingScheduler(int taskCount, int threadCount) : ranges(threadCount) {
+    for (int i = 0; i < threadCount; ++i) {
+        ranges[i].begin = taskCount/threadCount*i+(i < taskCount%threadCount ? i : taskCount%threadCount);
+        ranges[i].end = ranges[i].begin+taskCount/threadCount+(i < taskCount%threadCount);
+    }
+}
+
+int WorkStealingScheduler::next(int threadIndex) {
+    Range &own = ranges[threadIndex];
+    {
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.begin < own.end)
+            return own.begin++;
+    }
+    int threadCount = int(ranges.size());
+    for (int i = 1; i < threadCount; ++i) {
+        Range &victim = ranges[(threadIndex+i)%threadCount];
+        int begin, end;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.begin >= victim.end)
+                continue;
+            begin = victim.end-(victim.end-victim.begin+1)/2;
+            end = victim.end;
+            victim.end = begin;
+        }
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.begin = begin+1;
+        own.end = end;
+        return begin;
+    }
+    return -1;
+}
+
+#endif
+
+}
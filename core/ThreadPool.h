@@ -0,0 +1,147 @@
+
+#pragma once
+
+#include "base.h"
+
+#ifdef MSDFGEN_USE_THREADS
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+#ifdef MSDFGEN_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace msdfgen {
+
+/// Width and height in pixels of the tiles into which the parallel loops over the pixels of a bitmap are split.
+#define MSDFGEN_PARALLEL_TILE_SIZE 32
+
+/// Returns the number of threads that should execute a parallel task, given the configured thread count, where zero stands for the default of the threading backend.
+int resolveThreadCount(int threadCount);
+
+#ifdef MSDFGEN_USE_THREADS
+
+/// A pool of worker threads, which is used instead of OpenMP when built with MSDFGEN_USE_THREADS.
+class ThreadPool {
+
+public:
+    /// Returns the pool shared by all generator functions, which has a worker for each hardware thread except the calling one.
+    static ThreadPool &shared();
+
+    explicit ThreadPool(int workerCount);
+    ~ThreadPool();
+    /// Returns the number of worker threads.
+    int getWorkerCount() const;
+    /// Calls job(i) for each i in [0, jobCount) and waits for all of them to finish. The calling thread participates in the execution of the jobs.
+    void run(int jobCount, const std::function<void(int)> &job);
+
+private:
+    struct Batch {
+        const std::function<void(int)> *job;
+        int jobCount;
+        int nextJob;
+        int unfinishedJobs;
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<Batch *> batches;
+    std::mutex mutex;
+    std::condition_variable jobsAvailable;
+    std::condition_variable batchFinished;
+    bool terminating;
+
+    void workerMain();
+    /// Takes the next job of the front batch and executes it. The lock is released while the job runs.
+    void executeJob(std::unique_lock<std::mutex> &lock);
+
+    ThreadPool(const ThreadPool &);
+    ThreadPool &operator=(const ThreadPool &);
+
+};
+
+/**
+ * Distributes tasks [0, taskCount) between threads. Each thread starts with a contiguous range of tasks
+ * and processes it in order. Once it runs out, it steals the second half of the remaining range of another thread.
+ */
+class WorkStealingScheduler {
+
+public:
+    WorkStealingScheduler(int taskCount, int threadCount);
+    /// Returns the next task for the thread, or -1 if all tasks have been taken.
+    int next(int threadIndex);
+
+private:
+    struct Range {
+        std::mutex mutex;
+        int begin, end;
+    };
+
+    std::vector<Range> ranges;
+
+};
+
+#endif
+
+/**
+ * Processes tasks [0, taskCount) in parallel, using the available threading backend.
+ * Each thread constructs its own Job::Worker from job and calls it with each of its tasks.
+ * The tasks are distributed by WorkStealingScheduler, or by a dynamic schedule with OpenMP.
+ */
+template <class Job>
+void runParallelTasks(int taskCount, int threadCount, Job &job) {
+    if (threadCount > taskCount)
+        threadCount = taskCount;
+    if (threadCount > 1) {
+#if defined(MSDFGEN_USE_THREADS)
+        WorkStealingScheduler scheduler(taskCount, threadCount);
+        ThreadPool::shared().run(threadCount, [&job, &scheduler](int i) {
+            typename Job::Worker worker(job);
+            for (int task; (task = scheduler.next(i)) >= 0;)
+                worker(task);
+        });
+        return;
+#elif defined(MSDFGEN_USE_OPENMP)
+        #pragma omp parallel num_threads(threadCount)
+        {
+            typename Job::Worker worker(job);
+            #pragma omp for schedule(dynamic)
+            for (int task = 0; task < taskCount; ++task)
+                worker(task);
+        }
+        return;
+#endif
+    }
+    if (taskCount > 0) {
+        typename Job::Worker worker(job);
+        for (int task = 0; task < taskCount; ++task)
+            worker(task);
+    }
+}
+
+/// Calls job(i, threadCount) for each i in [0, threadCount) in parallel, using the available threading backend. Without one, job(0, 1) is called.
+template <class Job>
+void runParallel(int threadCount, Job &job) {
+    if (threadCount < 1)
+        threadCount = 1;
+#if defined(MSDFGEN_USE_THREADS)
+    if (threadCount > 1) {
+        ThreadPool::shared().run(threadCount, [&job, threadCount](int i) {
+            job(i, threadCount);
+        });
+    } else
+        job(0, 1);
+#elif defined(MSDFGEN_USE_OPENMP)
+    #pragma omp parallel num_threads(threadCount)
+    {
+        job(omp_get_thread_num(), omp_get_num_threads());
+    }
+#else
+    job(0, 1);
+#endif
+}
+
+}
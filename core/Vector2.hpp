@@ -7,16 +7,21 @@
 namespace msdfgen {
 
 /**
- * A 2-dimensional euclidean floating-point vector.
+ * A 2-dimensional euclidean floating-point vector of scalar type T.
  * @author Viktor Chlumsky
  */
-struct Vector2 {
+template <typename T>
+struct BasicVector2 {
 
-    double x, y;
+    T x, y;
 
-    inline Vector2(double val = 0) : x(val), y(val) { }
+    inline BasicVector2(T val = 0) : x(val), y(val) { }
 
-    inline Vector2(double x, double y) : x(x), y(y) { }
+    inline BasicVector2(T x, T y) : x(x), y(y) { }
+
+    /// Converts a vector of another scalar type.
+    template <typename S>
+    inline explicit BasicVector2(const BasicVector2<S> &other) : x(T(other.x)), y(T(other.y)) { }
 
     /// Sets the vector to zero.
     inline void reset() {
@@ -24,37 +29,37 @@ struct Vector2 {
     }
 
     /// Sets individual elements of the vector.
-    inline void set(double newX, double newY) {
+    inline void set(T newX, T newY) {
         x = newX, y = newY;
     }
 
     /// Returns the vector's squared length.
-    inline double squaredLength() const {
+    inline T squaredLength() const {
         return x*x+y*y;
     }
 
     /// Returns the vector's length.
-    inline double length() const {
+    inline T length() const {
         return sqrt(x*x+y*y);
     }
 
     /// Returns the normalized vector - one that has the same direction but unit length.
-    inline Vector2 normalize(bool allowZero = false) const {
-        if (double len = length())
-            return Vector2(x/len, y/len);
-        return Vector2(0, !allowZero);
+    inline BasicVector2 normalize(bool allowZero = false) const {
+        if (T len = length())
+            return BasicVector2(x/len, y/len);
+        return BasicVector2(0, !allowZero);
     }
 
     /// Returns a vector with the same length that is orthogonal to this one.
-    inline Vector2 getOrthogonal(bool polarity = true) const {
-        return polarity ? Vector2(-y, x) : Vector2(y, -x);
+    inline BasicVector2 getOrthogonal(bool polarity = true) const {
+        return polarity ? BasicVector2(-y, x) : BasicVector2(y, -x);
     }
 
     /// Returns a vector with unit length that is orthogonal to this one.
-    inline Vector2 getOrthonormal(bool polarity = true, bool allowZero = false) const {
-        if (double len = length())
-            return polarity ? Vector2(-y/len, x/len) : Vector2(y/len, -x/len);
-        return polarity ? Vector2(0, !allowZero) : Vector2(0, -!allowZero);
+    inline BasicVector2 getOrthonormal(bool polarity = true, bool allowZero = false) const {
+        if (T len = length())
+            return polarity ? BasicVector2(-y/len, x/len) : BasicVector2(y/len, -x/len);
+        return polarity ? BasicVector2(0, !allowZero) : BasicVector2(0, -!allowZero);
     }
 
 #ifdef MSDFGEN_USE_CPP11
@@ -67,101 +72,107 @@ struct Vector2 {
     }
 #endif
 
-    inline Vector2 &operator+=(const Vector2 other) {
+    inline BasicVector2 &operator+=(const BasicVector2 other) {
         x += other.x, y += other.y;
         return *this;
     }
 
-    inline Vector2 &operator-=(const Vector2 other) {
+    inline BasicVector2 &operator-=(const BasicVector2 other) {
         x -= other.x, y -= other.y;
         return *this;
     }
 
-    inline Vector2 &operator*=(const Vector2 other) {
+    inline BasicVector2 &operator*=(const BasicVector2 other) {
         x *= other.x, y *= other.y;
         return *this;
     }
 
-    inline Vector2 &operator/=(const Vector2 other) {
+    inline BasicVector2 &operator/=(const BasicVector2 other) {
         x /= other.x, y /= other.y;
         return *this;
     }
 
-    inline Vector2 &operator*=(double value) {
+    inline BasicVector2 &operator*=(T value) {
         x *= value, y *= value;
         return *this;
     }
 
-    inline Vector2 &operator/=(double value) {
+    inline BasicVector2 &operator/=(T value) {
         x /= value, y /= value;
         return *this;
     }
 
-};
+    /// Dot product of two vectors.
+    friend inline T dotProduct(const BasicVector2 a, const BasicVector2 b) {
+        return a.x*b.x+a.y*b.y;
+    }
 
-/// A vector may also represent a point, which shall be differentiated semantically using the alias Point2.
-typedef Vector2 Point2;
+    /// A special version of the cross product for 2D vectors (returns scalar value).
+    friend inline T crossProduct(const BasicVector2 a, const BasicVector2 b) {
+        return a.x*b.y-a.y*b.x;
+    }
 
-/// Dot product of two vectors.
-inline double dotProduct(const Vector2 a, const Vector2 b) {
-    return a.x*b.x+a.y*b.y;
-}
+    friend inline bool operator==(const BasicVector2 a, const BasicVector2 b) {
+        return a.x == b.x && a.y == b.y;
+    }
 
-/// A special version of the cross product for 2D vectors (returns scalar value).
-inline double crossProduct(const Vector2 a, const Vector2 b) {
-    return a.x*b.y-a.y*b.x;
-}
+    friend inline bool operator!=(const BasicVector2 a, const BasicVector2 b) {
+        return a.x != b.x || a.y != b.y;
+    }
 
-inline bool operator==(const Vector2 a, const Vector2 b) {
-    return a.x == b.x && a.y == b.y;
-}
+    friend inline BasicVector2 operator+(const BasicVector2 v) {
+        return v;
+    }
 
-inline bool operator!=(const Vector2 a, const Vector2 b) {
-    return a.x != b.x || a.y != b.y;
-}
+    friend inline BasicVector2 operator-(const BasicVector2 v) {
+        return BasicVector2(-v.x, -v.y);
+    }
 
-inline Vector2 operator+(const Vector2 v) {
-    return v;
-}
+    friend inline bool operator!(const BasicVector2 v) {
+        return !v.x && !v.y;
+    }
 
-inline Vector2 operator-(const Vector2 v) {
-    return Vector2(-v.x, -v.y);
-}
+    friend inline BasicVector2 operator+(const BasicVector2 a, const BasicVector2 b) {
+        return BasicVector2(a.x+b.x, a.y+b.y);
+    }
 
-inline bool operator!(const Vector2 v) {
-    return !v.x && !v.y;
-}
+    friend inline BasicVector2 operator-(const BasicVector2 a, const BasicVector2 b) {
+        return BasicVector2(a.x-b.x, a.y-b.y);
+    }
 
-inline Vector2 operator+(const Vector2 a, const Vector2 b) {
-    return Vector2(a.x+b.x, a.y+b.y);
-}
+    friend inline BasicVector2 operator*(const BasicVector2 a, const BasicVector2 b) {
+        return BasicVector2(a.x*b.x, a.y*b.y);
+    }
 
-inline Vector2 operator-(const Vector2 a, const Vector2 b) {
-    return Vector2(a.x-b.x, a.y-b.y);
-}
+    friend inline BasicVector2 operator/(const BasicVector2 a, const BasicVector2 b) {
+        return BasicVector2(a.x/b.x, a.y/b.y);
+    }
 
-inline Vector2 operator*(const Vector2 a, const Vector2 b) {
-    return Vector2(a.x*b.x, a.y*b.y);
-}
+    friend inline BasicVector2 operator*(T a, const BasicVector2 b) {
+        return BasicVector2(a*b.x, a*b.y);
+    }
 
-inline Vector2 operator/(const Vector2 a, const Vector2 b) {
-    return Vector2(a.x/b.x, a.y/b.y);
-}
+    friend inline BasicVector2 operator/(T a, const BasicVector2 b) {
+        return BasicVector2(a/b.x, a/b.y);
+    }
 
-inline Vector2 operator*(double a, const Vector2 b) {
-    return Vector2(a*b.x, a*b.y);
-}
+    friend inline BasicVector2 operator*(const BasicVector2 a, T b) {
+        return BasicVector2(a.x*b, a.y*b);
+    }
 
-inline Vector2 operator/(double a, const Vector2 b) {
-    return Vector2(a/b.x, a/b.y);
-}
+    friend inline BasicVector2 operator/(const BasicVector2 a, T b) {
+        return BasicVector2(a.x/b, a.y/b);
+    }
 
-inline Vector2 operator*(const Vector2 a, double b) {
-    return Vector2(a.x*b, a.y*b);
-}
+};
 
-inline Vector2 operator/(const Vector2 a, double b) {
-    return Vector2(a.x/b, a.y/b);
-}
+/// A 2-dimensional vector with double precision, used throughout the library.
+typedef BasicVector2<double> Vector2;
+/// A 2-dimensional vector with single precision, used by the single-precision distance field generator.
+typedef BasicVector2<float> FloatVector2;
+
+/// A vector may also represent a point, which shall be differentiated semantically using the alias Point2.
+typedef Vector2 Point2;
+typedef FloatVector2 FloatPoint2;
 
 }
@@ -12,5 +12,6 @@
 namespace msdfgen {
 
 typedef unsigned char byte;
+typedef unsigned short uint16;
 
 }
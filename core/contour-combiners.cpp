@@ -2,32 +2,155 @@
 #include "contour-combiners.h"
 
 #include <cfloat>
+#include <limits>
+#include <algorithm>
 #include "arithmetics.hpp"
 
+// Relative margin by which the distance to a contour's bounding box must exceed the selected distance to skip it, which covers the rounding errors of single-precision distances
+#define CONTOUR_CULLING_MARGIN 1.0001
+// The number of times edges are split in thirds when testing whether a contour intersects itself
+#define SELF_INTERSECTION_TEST_DEPTH 3
+
 namespace msdfgen {
 
+static Shape::Bounds edgeBounds(const EdgeSegment *edge) {
+    Shape::Bounds bounds = { +DBL_MAX, +DBL_MAX, -DBL_MAX, -DBL_MAX };
+    edge->bound(bounds.l, bounds.b, bounds.r, bounds.t);
+    return bounds;
+}
+
+static bool boundsOverlap(const Shape::Bounds &a, const Shape::Bounds &b) {
+    return a.l <= b.r && b.l <= a.r && a.b <= b.t && b.b <= a.t;
+}
+
+/// Returns false if edges a and b provably do not intersect, except at their shared endpoint if adjacent (a ends where b starts).
+static bool mayIntersect(const EdgeSegment *a, const EdgeSegment *b, bool adjacent, int depth) {
+    if (!adjacent && !boundsOverlap(edgeBounds(a), edgeBounds(b)))
+        return false;
+    if (!depth) {
+        if (!adjacent)
+            return true;
+        // Near the shared endpoint, the edges may only intersect if they leave it in the same direction
+        return dotProduct(a->direction(1).normalize(), b->direction(0).normalize()) < MSDFGEN_CORNER_DOT_EPSILON-1;
+    }
+    EdgeSegment *aParts[3] = { }, *bParts[3] = { };
+    a->splitInThirds(aParts[0], aParts[1], aParts[2]);
+    b->splitInThirds(bParts[0], bParts[1], bParts[2]);
+    bool result = false;
+    for (int i = 0; i < 3 && !result; ++i)
+        for (int j = 0; j < 3 && !result; ++j)
+            result = mayIntersect(aParts[i], bParts[j], adjacent && i == 2 && j == 0, depth-1);
+    for (int i = 0; i < 3; ++i) {
+        delete aParts[i];
+        delete bParts[i];
+    }
+    return result;
+}
+
+/// Returns false if the edge provably does not intersect itself.
+static bool mayIntersectItself(const EdgeSegment *edge, int depth) {
+    if (edge->type() != (int) CubicSegment::EDGE_TYPE || !depth)
+        return false;
+    EdgeSegment *parts[3] = { };
+    edge->splitInThirds(parts[0], parts[1], parts[2]);
+    bool result = (
+        mayIntersect(parts[0], parts[1], true, depth-1) ||
+        mayIntersect(parts[1], parts[2], true, depth-1) ||
+        mayIntersect(parts[0], parts[2], false, depth-1) ||
+        mayIntersectItself(parts[0], depth-1) ||
+        mayIntersectItself(parts[1], depth-1) ||
+        mayIntersectItself(parts[2], depth-1)
+    );
+    for (int i = 0; i < 3; ++i)
+        delete parts[i];
+    return result;
+}
+
+struct EdgeBoundsOrder {
+    const std::vector<Shape::Bounds> &bounds;
+    explicit EdgeBoundsOrder(const std::vector<Shape::Bounds> &bounds) : bounds(bounds) { }
+    bool operator()(int a, int b) const {
+        return bounds[a].l < bounds[b].l;
+    }
+};
+
+/// Returns true if the contour provably does not intersect itself. Some contours without self-intersections may not be recognized.
+static bool isContourSimple(const Contour &contour) {
+    int n = (int) contour.edges.size();
+    if (n < 3)
+        return false;
+    std::vector<Shape::Bounds> bounds(n);
+    std::vector<int> order(n);
+    for (int i = 0; i < n; ++i) {
+        if (mayIntersectItself(contour.edges[i], SELF_INTERSECTION_TEST_DEPTH))
+            return false;
+        bounds[i] = edgeBounds(contour.edges[i]);
+        order[i] = i;
+    }
+    // Sweep over the edges ordered by the left side of their bounding boxes
+    std::sort(order.begin(), order.end(), EdgeBoundsOrder(bounds));
+    for (int i = 0; i < n; ++i) {
+        for (int j = i+1; j < n && bounds[order[j]].l <= bounds[order[i]].r; ++j) {
+            int a = order[i], b = order[j];
+            if (!boundsOverlap(bounds[a], bounds[b]))
+                continue;
+            if ((a+1)%n == b) {
+                if (mayIntersect(contour.edges[a], contour.edges[b], true, SELF_INTERSECTION_TEST_DEPTH))
+                    return false;
+            } else if ((b+1)%n == a) {
+                if (mayIntersect(contour.edges[b], contour.edges[a], true, SELF_INTERSECTION_TEST_DEPTH))
+                    return false;
+            } else if (mayIntersect(contour.edges[a], contour.edges[b], false, SELF_INTERSECTION_TEST_DEPTH))
+                return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+static bool supportsContourCulling(const BasicTrueDistanceSelector<T> *) {
+    return true;
+}
+
+template <class EdgeSelector>
+static bool supportsContourCulling(const EdgeSelector *) {
+    // Perpendicular distances are not bounded by the distance to the contour
+    return false;
+}
+
 static void initDistance(double &distance) {
     distance = -DBL_MAX;
 }
 
-static void initDistance(MultiDistance &distance) {
-    distance.r = -DBL_MAX;
-    distance.g = -DBL_MAX;
-    distance.b = -DBL_MAX;
+static void initDistance(float &distance) {
+    distance = -FLT_MAX;
 }
 
-static void initDistance(MultiAndTrueDistance &distance) {
-    distance.r = -DBL_MAX;
-    distance.g = -DBL_MAX;
-    distance.b = -DBL_MAX;
-    distance.a = -DBL_MAX;
+template <typename T>
+static void initDistance(BasicMultiDistance<T> &distance) {
+    distance.r = -std::numeric_limits<T>::max();
+    distance.g = -std::numeric_limits<T>::max();
+    distance.b = -std::numeric_limits<T>::max();
+}
+
+template <typename T>
+static void initDistance(BasicMultiAndTrueDistance<T> &distance) {
+    distance.r = -std::numeric_limits<T>::max();
+    distance.g = -std::numeric_limits<T>::max();
+    distance.b = -std::numeric_limits<T>::max();
+    distance.a = -std::numeric_limits<T>::max();
 }
 
 static double resolveDistance(double distance) {
     return distance;
 }
 
-static double resolveDistance(const MultiDistance &distance) {
+static float resolveDistance(float distance) {
+    return distance;
+}
+
+template <typename T>
+static T resolveDistance(const BasicMultiDistance<T> &distance) {
     return median(distance.r, distance.g, distance.b);
 }
 
@@ -39,6 +162,26 @@ void SimpleContourCombiner<EdgeSelector>::reset(const Point2 &p) {
     shapeEdgeSelector.reset(p);
 }
 
+template <class EdgeSelector>
+bool SimpleContourCombiner<EdgeSelector>::deferContour(int) {
+    return false;
+}
+
+template <class EdgeSelector>
+bool SimpleContourCombiner<EdgeSelector>::isContourDeferred(int) const {
+    return false;
+}
+
+template <class EdgeSelector>
+bool SimpleContourCombiner<EdgeSelector>::isContourRelevant(int) {
+    return true;
+}
+
+template <class EdgeSelector>
+double SimpleContourCombiner<EdgeSelector>::deferredContourDistance(int) const {
+    return 0;
+}
+
 template <class EdgeSelector>
 EdgeSelector &SimpleContourCombiner<EdgeSelector>::edgeSelector(int) {
     return shapeEdgeSelector;
@@ -53,13 +196,31 @@ template class SimpleContourCombiner<TrueDistanceSelector>;
 template class SimpleContourCombiner<PerpendicularDistanceSelector>;
 template class SimpleContourCombiner<MultiDistanceSelector>;
 template class SimpleContourCombiner<MultiAndTrueDistanceSelector>;
+template class SimpleContourCombiner<BasicTrueDistanceSelector<float> >;
+template class SimpleContourCombiner<BasicPerpendicularDistanceSelector<float> >;
+template class SimpleContourCombiner<BasicMultiDistanceSelector<float> >;
+template class SimpleContourCombiner<BasicMultiAndTrueDistanceSelector<float> >;
 
 template <class EdgeSelector>
-OverlappingContourCombiner<EdgeSelector>::OverlappingContourCombiner(const Shape &shape) {
+OverlappingContourCombiner<EdgeSelector>::OverlappingContourCombiner(const Shape &shape) : contourCulling(supportsContourCulling((const EdgeSelector *) NULL)), cullingBound(0), cullingBoundInitialized(false), nearestContourSelected(false), lastRelevantContour(-1) {
     windings.reserve(shape.contours.size());
     for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour)
         windings.push_back(contour->winding());
     edgeSelectors.resize(shape.contours.size());
+    contourDistances.resize(shape.contours.size());
+    deferredContours.resize(shape.contours.size());
+    if (contourCulling) {
+        contourBounds.reserve(shape.contours.size());
+        cullableContours.reserve(shape.contours.size());
+        for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour) {
+            Shape::Bounds bounds = { +DBL_MAX, +DBL_MAX, -DBL_MAX, -DBL_MAX };
+            contour->bound(bounds.l, bounds.b, bounds.r, bounds.t);
+            contourBounds.push_back(bounds);
+            // The sign of the distance outside the contour is only known if it does not intersect itself, and does not matter if its winding is zero
+            cullableContours.push_back(windings[contour-shape.contours.begin()] == 0 || isContourSimple(*contour));
+        }
+        boundDistances.resize(shape.contours.size());
+    }
 }
 
 template <class EdgeSelector>
@@ -67,6 +228,53 @@ void OverlappingContourCombiner<EdgeSelector>::reset(const Point2 &p) {
     this->p = p;
     for (typename std::vector<EdgeSelector>::iterator contourEdgeSelector = edgeSelectors.begin(); contourEdgeSelector != edgeSelectors.end(); ++contourEdgeSelector)
         contourEdgeSelector->reset(p);
+    for (std::vector<char>::iterator deferred = deferredContours.begin(); deferred != deferredContours.end(); ++deferred)
+        *deferred = false;
+    cullingBoundInitialized = false;
+    lastRelevantContour = -1;
+}
+
+template <class EdgeSelector>
+bool OverlappingContourCombiner<EdgeSelector>::deferContour(int i) {
+    if (!contourCulling || !cullableContours[i])
+        return false;
+    const Shape::Bounds &bounds = contourBounds[i];
+    double dx = max(max(bounds.l-p.x, p.x-bounds.r), 0.);
+    double dy = max(max(bounds.b-p.y, p.y-bounds.t), 0.);
+    if (dx || dy) {
+        deferredContours[i] = true;
+        boundDistances[i] = sqrt(dx*dx+dy*dy);
+        return true;
+    }
+    return false;
+}
+
+template <class EdgeSelector>
+bool OverlappingContourCombiner<EdgeSelector>::isContourDeferred(int i) const {
+    return deferredContours[i] != 0;
+}
+
+template <class EdgeSelector>
+bool OverlappingContourCombiner<EdgeSelector>::isContourRelevant(int i) {
+    // The point is outside the deferred contours, so they may only be selected if they are nearer than the contour selected among the others.
+    // Unless the nearest contour is selected, this holds for the distance selected before any deferred contours are evaluated.
+    if (!cullingBoundInitialized) {
+        cullingBound = fabs(resolveDistance(selectDistance(nearestContourSelected)));
+        cullingBoundInitialized = true;
+    } else if (lastRelevantContour >= 0 && nearestContourSelected)
+        cullingBound = min(cullingBound, fabs(double(resolveDistance(edgeSelectors[lastRelevantContour].distance()))));
+    lastRelevantContour = -1;
+    if (!deferredContours[i] || boundDistances[i] > CONTOUR_CULLING_MARGIN*cullingBound)
+        return false;
+    deferredContours[i] = false;
+    lastRelevantContour = i;
+    return true;
+}
+
+template <class EdgeSelector>
+double OverlappingContourCombiner<EdgeSelector>::deferredContourDistance(int i) const {
+    // The distance to the contour's bounding box.
+    return boundDistances[i];
 }
 
 template <class EdgeSelector>
@@ -76,6 +284,13 @@ EdgeSelector &OverlappingContourCombiner<EdgeSelector>::edgeSelector(int i) {
 
 template <class EdgeSelector>
 typename OverlappingContourCombiner<EdgeSelector>::DistanceType OverlappingContourCombiner<EdgeSelector>::distance() const {
+    bool nearest;
+    return selectDistance(nearest);
+}
+
+template <class EdgeSelector>
+typename OverlappingContourCombiner<EdgeSelector>::DistanceType OverlappingContourCombiner<EdgeSelector>::selectDistance(bool &nearestContourSelected) const {
+    // Deferred contours that have not been evaluated are skipped
     int contourCount = (int) edgeSelectors.size();
     EdgeSelector shapeEdgeSelector;
     EdgeSelector innerEdgeSelector;
@@ -84,7 +299,9 @@ typename OverlappingContourCombiner<EdgeSelector>::DistanceType OverlappingConto
     innerEdgeSelector.reset(p);
     outerEdgeSelector.reset(p);
     for (int i = 0; i < contourCount; ++i) {
-        DistanceType edgeDistance = edgeSelectors[i].distance();
+        if (deferredContours[i])
+            continue;
+        DistanceType edgeDistance = contourDistances[i] = edgeSelectors[i].distance();
         shapeEdgeSelector.merge(edgeSelectors[i]);
         if (windings[i] > 0 && resolveDistance(edgeDistance) >= 0)
             innerEdgeSelector.merge(edgeSelectors[i]);
@@ -99,14 +316,15 @@ typename OverlappingContourCombiner<EdgeSelector>::DistanceType OverlappingConto
     double outerScalarDistance = resolveDistance(outerDistance);
     DistanceType distance;
     initDistance(distance);
+    nearestContourSelected = false;
 
     int winding = 0;
     if (innerScalarDistance >= 0 && fabs(innerScalarDistance) <= fabs(outerScalarDistance)) {
         distance = innerDistance;
         winding = 1;
         for (int i = 0; i < contourCount; ++i)
-            if (windings[i] > 0) {
-                DistanceType contourDistance = edgeSelectors[i].distance();
+            if (windings[i] > 0 && !deferredContours[i]) {
+                const DistanceType &contourDistance = contourDistances[i];
                 if (fabs(resolveDistance(contourDistance)) < fabs(outerScalarDistance) && resolveDistance(contourDistance) > resolveDistance(distance))
                     distance = contourDistance;
             }
@@ -114,17 +332,19 @@ typename OverlappingContourCombiner<EdgeSelector>::DistanceType OverlappingConto
         distance = outerDistance;
         winding = -1;
         for (int i = 0; i < contourCount; ++i)
-            if (windings[i] < 0) {
-                DistanceType contourDistance = edgeSelectors[i].distance();
+            if (windings[i] < 0 && !deferredContours[i]) {
+                const DistanceType &contourDistance = contourDistances[i];
                 if (fabs(resolveDistance(contourDistance)) < fabs(innerScalarDistance) && resolveDistance(contourDistance) < resolveDistance(distance))
                     distance = contourDistance;
             }
-    } else
+    } else {
+        nearestContourSelected = true;
         return shapeDistance;
+    }
 
     for (int i = 0; i < contourCount; ++i)
-        if (windings[i] != winding) {
-            DistanceType contourDistance = edgeSelectors[i].distance();
+        if (windings[i] != winding && !deferredContours[i]) {
+            const DistanceType &contourDistance = contourDistances[i];
             if (resolveDistance(contourDistance)*resolveDistance(distance) >= 0 && fabs(resolveDistance(contourDistance)) < fabs(resolveDistance(distance)))
                 distance = contourDistance;
         }
@@ -137,5 +357,9 @@ template class OverlappingContourCombiner<TrueDistanceSelector>;
 template class OverlappingContourCombiner<PerpendicularDistanceSelector>;
 template class OverlappingContourCombiner<MultiDistanceSelector>;
 template class OverlappingContourCombiner<MultiAndTrueDistanceSelector>;
+template class OverlappingContourCombiner<BasicTrueDistanceSelector<float> >;
+template class OverlappingContourCombiner<BasicPerpendicularDistanceSelector<float> >;
+template class OverlappingContourCombiner<BasicMultiDistanceSelector<float> >;
+template class OverlappingContourCombiner<BasicMultiAndTrueDistanceSelector<float> >;
 
 }
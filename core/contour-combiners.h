@@ -16,6 +16,14 @@ public:
 
     explicit SimpleContourCombiner(const Shape &shape);
     void reset(const Point2 &p);
+    /// Returns whether the evaluation of the edges of the i-th contour may be deferred until isContourRelevant determines if they can affect the distance. Never the case for this combiner.
+    bool deferContour(int i);
+    /// Returns whether the evaluation of the edges of the i-th contour has been deferred and not yet requested by isContourRelevant.
+    bool isContourDeferred(int i) const;
+    /// Returns whether the edges of a deferred contour have to be evaluated after those of all other contours have been.
+    bool isContourRelevant(int i);
+    /// Returns a lower bound of the distance between the point and the edges of a deferred contour.
+    double deferredContourDistance(int i) const;
     EdgeSelector &edgeSelector(int i);
     DistanceType distance() const;
 
@@ -24,7 +32,11 @@ private:
 
 };
 
-/// Selects the nearest contour that actually forms a border between filled and unfilled area.
+/**
+ * Selects the nearest contour that actually forms a border between filled and unfilled area.
+ * For true distance selectors, the contours whose bounding box does not contain the point are deferred, and skipped if the distance to their bounding box exceeds the distance selected among the other contours.
+ * This does not affect the result, since the distance of a point outside the bounding box of a contour without self-intersections has the sign of its exterior. Contours that may intersect themselves are never skipped.
+ */
 template <class EdgeSelector>
 class OverlappingContourCombiner {
 
@@ -34,6 +46,10 @@ public:
 
     explicit OverlappingContourCombiner(const Shape &shape);
     void reset(const Point2 &p);
+    bool deferContour(int i);
+    bool isContourDeferred(int i) const;
+    bool isContourRelevant(int i);
+    double deferredContourDistance(int i) const;
     EdgeSelector &edgeSelector(int i);
     DistanceType distance() const;
 
@@ -41,6 +57,21 @@ private:
     Point2 p;
     std::vector<int> windings;
     std::vector<EdgeSelector> edgeSelectors;
+    /// The distance of each contour's selector, computed once per query.
+    mutable std::vector<DistanceType> contourDistances;
+    /// Contour culling - the bounding boxes of the contours, the distances of the point to them and whether the contours are deferred.
+    bool contourCulling;
+    std::vector<Shape::Bounds> contourBounds;
+    std::vector<double> boundDistances;
+    std::vector<char> cullableContours;
+    std::vector<char> deferredContours;
+    /// An upper bound of the absolute selected distance, valid once cullingBoundInitialized, and the last deferred contour whose evaluation was requested.
+    double cullingBound;
+    bool cullingBoundInitialized;
+    bool nearestContourSelected;
+    int lastRelevantContour;
+
+    DistanceType selectDistance(bool &nearestContourSelected) const;
 
 };
 
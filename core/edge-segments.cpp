@@ -1,11 +1,31 @@
 
 #include "edge-segments.h"
 
+#include <new>
 #include "arithmetics.hpp"
 #include "equation-solver.h"
+#include "EdgeSegmentArena.h"
 
 namespace msdfgen {
 
+/// Each edge segment is preceded by a header, which holds the arena it was allocated from, or NULL if it was allocated on the heap.
+static const size_t EDGE_SEGMENT_HEADER_SIZE = 16;
+
+void *EdgeSegment::operator new(size_t size) {
+    EdgeSegmentArena *arena = EdgeSegmentArena::current();
+    char *memory = static_cast<char *>(arena ? arena->allocate(EDGE_SEGMENT_HEADER_SIZE+size) : ::operator new(EDGE_SEGMENT_HEADER_SIZE+size));
+    *reinterpret_cast<EdgeSegmentArena **>(memory) = arena;
+    return memory+EDGE_SEGMENT_HEADER_SIZE;
+}
+
+void EdgeSegment::operator delete(void *ptr) {
+    if (ptr) {
+        char *memory = static_cast<char *>(ptr)-EDGE_SEGMENT_HEADER_SIZE;
+        if (!*reinterpret_cast<EdgeSegmentArena **>(memory))
+            ::operator delete(memory);
+    }
+}
+
 EdgeSegment *EdgeSegment::create(Point2 p0, Point2 p1, EdgeColor edgeColor) {
     return new LinearSegment(p0, p1, edgeColor);
 }
@@ -25,24 +45,25 @@ EdgeSegment *EdgeSegment::create(Point2 p0, Point2 p1, Point2 p2, Point2 p3, Edg
     return new CubicSegment(p0, p1, p2, p3, edgeColor);
 }
 
-void EdgeSegment::distanceToPerpendicularDistance(SignedDistance &distance, Point2 origin, double param) const {
+template <typename T>
+static void distanceToPerpendicularDistance(const EdgeSegment *edge, BasicSignedDistance<T> &distance, BasicVector2<T> origin, T param) {
     if (param < 0) {
-        Vector2 dir = direction(0).normalize();
-        Vector2 aq = origin-point(0);
-        double ts = dotProduct(aq, dir);
+        BasicVector2<T> dir = BasicVector2<T>(edge->direction(0)).normalize();
+        BasicVector2<T> aq = origin-BasicVector2<T>(edge->point(0));
+        T ts = dotProduct(aq, dir);
         if (ts < 0) {
-            double perpendicularDistance = crossProduct(aq, dir);
+            T perpendicularDistance = crossProduct(aq, dir);
             if (fabs(perpendicularDistance) <= fabs(distance.distance)) {
                 distance.distance = perpendicularDistance;
                 distance.dot = 0;
             }
         }
     } else if (param > 1) {
-        Vector2 dir = direction(1).normalize();
-        Vector2 bq = origin-point(1);
-        double ts = dotProduct(bq, dir);
+        BasicVector2<T> dir = BasicVector2<T>(edge->direction(1)).normalize();
+        BasicVector2<T> bq = origin-BasicVector2<T>(edge->point(1));
+        T ts = dotProduct(bq, dir);
         if (ts > 0) {
-            double perpendicularDistance = crossProduct(bq, dir);
+            T perpendicularDistance = crossProduct(bq, dir);
             if (fabs(perpendicularDistance) <= fabs(distance.distance)) {
                 distance.distance = perpendicularDistance;
                 distance.dot = 0;
@@ -51,6 +72,21 @@ void EdgeSegment::distanceToPerpendicularDistance(SignedDistance &distance, Poin
     }
 }
 
+void EdgeSegment::distanceToPerpendicularDistance(SignedDistance &distance, Point2 origin, double param) const {
+    msdfgen::distanceToPerpendicularDistance(this, distance, origin, param);
+}
+
+FloatSignedDistance EdgeSegment::signedDistance(FloatPoint2 origin, float &param) const {
+    double doubleParam;
+    FloatSignedDistance distance(signedDistance(Point2(origin), doubleParam));
+    param = float(doubleParam);
+    return distance;
+}
+
+void EdgeSegment::distanceToPerpendicularDistance(FloatSignedDistance &distance, FloatPoint2 origin, float param) const {
+    msdfgen::distanceToPerpendicularDistance(this, distance, origin, param);
+}
+
 LinearSegment::LinearSegment(Point2 p0, Point2 p1, EdgeColor edgeColor) : EdgeSegment(edgeColor) {
     p[0] = p0;
     p[1] = p1;
@@ -170,104 +206,281 @@ double QuadraticSegment::length() const {
     )/(brbr*brLen);
 }
 
-SignedDistance LinearSegment::signedDistance(Point2 origin, double &param) const {
-    Vector2 aq = origin-p[0];
-    Vector2 ab = p[1]-p[0];
-    param = dotProduct(aq, ab)/dotProduct(ab, ab);
-    Vector2 eq = p[param > .5]-origin;
-    double endpointDistance = eq.length();
+template <typename T>
+static void linearCoefficients(const LinearSegment &edge, BasicEdgeCoefficients<T> &coefficients) {
+    for (int i = 0; i < 2; ++i)
+        coefficients.p[i] = BasicVector2<T>(edge.p[i]);
+    coefficients.ab = coefficients.p[1]-coefficients.p[0];
+    coefficients.abLengthSquared = dotProduct(coefficients.ab, coefficients.ab);
+    coefficients.orthonormal = coefficients.ab.getOrthonormal(false);
+    coefficients.aNormalizedDir = coefficients.ab.normalize();
+}
+
+template <typename T>
+static BasicSignedDistance<T> linearSignedDistance(const BasicEdgeCoefficients<T> &coefficients, BasicVector2<T> origin, T &param) {
+    const BasicVector2<T> *P = coefficients.p;
+    BasicVector2<T> aq = origin-P[0];
+    param = dotProduct(aq, coefficients.ab)/coefficients.abLengthSquared;
+    BasicVector2<T> eq = P[param > .5]-origin;
+    T endpointDistance = eq.length();
     if (param > 0 && param < 1) {
-        double orthoDistance = dotProduct(ab.getOrthonormal(false), aq);
+        T orthoDistance = dotProduct(coefficients.orthonormal, aq);
         if (fabs(orthoDistance) < endpointDistance)
-            return SignedDistance(orthoDistance, 0);
+            return BasicSignedDistance<T>(orthoDistance, 0);
     }
-    return SignedDistance(nonZeroSign(crossProduct(aq, ab))*endpointDistance, fabs(dotProduct(ab.normalize(), eq.normalize())));
-}
-
-SignedDistance QuadraticSegment::signedDistance(Point2 origin, double &param) const {
-    Vector2 qa = p[0]-origin;
-    Vector2 ab = p[1]-p[0];
-    Vector2 br = p[2]-p[1]-ab;
-    double a = dotProduct(br, br);
-    double b = 3*dotProduct(ab, br);
-    double c = 2*dotProduct(ab, ab)+dotProduct(qa, br);
-    double d = dotProduct(qa, ab);
+    return BasicSignedDistance<T>(nonZeroSign(crossProduct(aq, coefficients.ab))*endpointDistance, fabs(dotProduct(coefficients.aNormalizedDir, eq.normalize())));
+}
+
+template <typename T>
+static void quadraticCoefficients(const QuadraticSegment &edge, BasicEdgeCoefficients<T> &coefficients) {
+    for (int i = 0; i < 3; ++i)
+        coefficients.p[i] = BasicVector2<T>(edge.p[i]);
+    coefficients.ab = coefficients.p[1]-coefficients.p[0];
+    coefficients.br = coefficients.p[2]-coefficients.p[1]-coefficients.ab;
+    coefficients.a = dotProduct(coefficients.br, coefficients.br);
+    coefficients.b = 3*dotProduct(coefficients.ab, coefficients.br);
+    coefficients.abab2 = 2*dotProduct(coefficients.ab, coefficients.ab);
+    coefficients.aDir = BasicVector2<T>(edge.direction(0));
+    coefficients.bDir = BasicVector2<T>(edge.direction(1));
+    coefficients.aDirLengthSquared = dotProduct(coefficients.aDir, coefficients.aDir);
+    coefficients.bDirLengthSquared = dotProduct(coefficients.bDir, coefficients.bDir);
+    coefficients.aNormalizedDir = coefficients.aDir.normalize();
+    coefficients.bNormalizedDir = coefficients.bDir.normalize();
+}
+
+template <typename T>
+static BasicSignedDistance<T> quadraticSignedDistance(const BasicEdgeCoefficients<T> &coefficients, BasicVector2<T> origin, T &param) {
+    const BasicVector2<T> *P = coefficients.p;
+    const BasicVector2<T> &ab = coefficients.ab, &br = coefficients.br;
+    BasicVector2<T> qa = P[0]-origin;
+    T c = coefficients.abab2+dotProduct(qa, br);
+    T d = dotProduct(qa, ab);
     double t[3];
-    int solutions = solveCubic(t, a, b, c, d);
+    int solutions = solveCubic(t, coefficients.a, coefficients.b, c, d);
 
-    Vector2 epDir = direction(0);
-    double minDistance = nonZeroSign(crossProduct(epDir, qa))*qa.length(); // distance from A
-    param = -dotProduct(qa, epDir)/dotProduct(epDir, epDir);
+    T minDistance = nonZeroSign(crossProduct(coefficients.aDir, qa))*qa.length(); // distance from A
+    param = -dotProduct(qa, coefficients.aDir)/coefficients.aDirLengthSquared;
     {
-        epDir = direction(1);
-        double distance = (p[2]-origin).length(); // distance from B
+        T distance = (P[2]-origin).length(); // distance from B
         if (distance < fabs(minDistance)) {
-            minDistance = nonZeroSign(crossProduct(epDir, p[2]-origin))*distance;
-            param = dotProduct(origin-p[1], epDir)/dotProduct(epDir, epDir);
+            minDistance = nonZeroSign(crossProduct(coefficients.bDir, P[2]-origin))*distance;
+            param = dotProduct(origin-P[1], coefficients.bDir)/coefficients.bDirLengthSquared;
         }
     }
     for (int i = 0; i < solutions; ++i) {
-        if (t[i] > 0 && t[i] < 1) {
-            Point2 qe = qa+2*t[i]*ab+t[i]*t[i]*br;
-            double distance = qe.length();
+        T ti = T(t[i]);
+        if (ti > 0 && ti < 1) {
+            BasicVector2<T> qe = qa+2*ti*ab+ti*ti*br;
+            T distance = qe.length();
             if (distance <= fabs(minDistance)) {
-                minDistance = nonZeroSign(crossProduct(ab+t[i]*br, qe))*distance;
-                param = t[i];
+                minDistance = nonZeroSign(crossProduct(ab+ti*br, qe))*distance;
+                param = ti;
             }
         }
     }
 
     if (param >= 0 && param <= 1)
-        return SignedDistance(minDistance, 0);
+        return BasicSignedDistance<T>(minDistance, 0);
     if (param < .5)
-        return SignedDistance(minDistance, fabs(dotProduct(direction(0).normalize(), qa.normalize())));
+        return BasicSignedDistance<T>(minDistance, fabs(dotProduct(coefficients.aNormalizedDir, qa.normalize())));
+    else
+        return BasicSignedDistance<T>(minDistance, fabs(dotProduct(coefficients.bNormalizedDir, (P[2]-origin).normalize())));
+}
+
+static const double QUARTER_TURN = .78539816339744830962;
+
+/// Determines the number of starting points and the maximum number of iterations of the nearest point search of a cubic curve for the given tolerance (in shape units).
+static void cubicSearchEffort(const Point2 p[4], double tolerance, int &starts, int &steps) {
+    // The control polygon bounds the curve, so if it is within tolerance of the chord, the curve can be treated as nearly straight.
+    Vector2 chord = p[3]-p[0];
+    double chordLength = chord.length();
+    double deviation = 0;
+    for (int i = 1; i < 3; ++i)
+        deviation = max(deviation, chordLength ? fabs(crossProduct(chord, p[i]-p[0]))/chordLength : (p[i]-p[0]).length());
+    // Each local minimum of the distance corresponds to a part of the curve whose tangent turns by less than half a turn, so fewer starting points are needed if the curve turns less.
+    // The turning of the control polygon bounds that of the curve, and if it turns in both directions, the curve may have an inflection point.
+    Vector2 legs[3] = { p[1]-p[0], p[2]-p[1], p[3]-p[2] };
+    double turning = 0;
+    int turningSign = 0;
+    bool inflection = false;
+    const Vector2 *prevLeg = NULL;
+    for (int i = 0; i < 3; ++i) {
+        if (!legs[i])
+            continue;
+        if (prevLeg) {
+            double cross = crossProduct(*prevLeg, legs[i]);
+            turning += fabs(atan2(cross, dotProduct(*prevLeg, legs[i])));
+            if (cross) {
+                if (turningSign && sign(cross) != turningSign)
+                    inflection = true;
+                turningSign = sign(cross);
+            }
+        }
+        prevLeg = legs+i;
+    }
+    if (deviation <= tolerance)
+        starts = 1;
     else
-        return SignedDistance(minDistance, fabs(dotProduct(direction(1).normalize(), (p[2]-origin).normalize())));
+        starts = min(int(ceil(turning/QUARTER_TURN))+int(inflection), 2*MSDFGEN_CUBIC_SEARCH_STARTS);
+    starts = max(starts, 1);
+    // The iterations terminate early once they converge within tolerance.
+    steps = 2*MSDFGEN_CUBIC_SEARCH_STEPS;
+}
+
+template <typename T>
+static void cubicCoefficients(const CubicSegment &edge, BasicEdgeCoefficients<T> &coefficients, double searchTolerance) {
+    for (int i = 0; i < 4; ++i)
+        coefficients.p[i] = BasicVector2<T>(edge.p[i]);
+    const BasicVector2<T> *P = coefficients.p;
+    coefficients.ab = P[1]-P[0];
+    coefficients.br = P[2]-P[1]-coefficients.ab;
+    coefficients.as = (P[3]-P[2])-(P[2]-P[1])-coefficients.br;
+    coefficients.aDir = BasicVector2<T>(edge.direction(0));
+    coefficients.bDir = BasicVector2<T>(edge.direction(1));
+    coefficients.aDirLengthSquared = dotProduct(coefficients.aDir, coefficients.aDir);
+    coefficients.bDirLengthSquared = dotProduct(coefficients.bDir, coefficients.bDir);
+    coefficients.aNormalizedDir = coefficients.aDir.normalize();
+    coefficients.bNormalizedDir = coefficients.bDir.normalize();
+    if (searchTolerance > 0) {
+        cubicSearchEffort(edge.p, searchTolerance, coefficients.searchStarts, coefficients.searchSteps);
+        coefficients.squaredSearchTolerance = T(searchTolerance*searchTolerance);
+    } else {
+        coefficients.searchStarts = MSDFGEN_CUBIC_SEARCH_STARTS;
+        coefficients.searchSteps = MSDFGEN_CUBIC_SEARCH_STEPS;
+        coefficients.squaredSearchTolerance = T(0);
+    }
 }
 
-SignedDistance CubicSegment::signedDistance(Point2 origin, double &param) const {
-    Vector2 qa = p[0]-origin;
-    Vector2 ab = p[1]-p[0];
-    Vector2 br = p[2]-p[1]-ab;
-    Vector2 as = (p[3]-p[2])-(p[2]-p[1])-br;
+template <typename T>
+static BasicSignedDistance<T> cubicSignedDistance(const BasicEdgeCoefficients<T> &coefficients, BasicVector2<T> origin, T &param) {
+    const BasicVector2<T> *P = coefficients.p;
+    const BasicVector2<T> &ab = coefficients.ab, &br = coefficients.br, &as = coefficients.as;
+    BasicVector2<T> qa = P[0]-origin;
 
-    Vector2 epDir = direction(0);
-    double minDistance = nonZeroSign(crossProduct(epDir, qa))*qa.length(); // distance from A
-    param = -dotProduct(qa, epDir)/dotProduct(epDir, epDir);
+    T minDistance = nonZeroSign(crossProduct(coefficients.aDir, qa))*qa.length(); // distance from A
+    param = -dotProduct(qa, coefficients.aDir)/coefficients.aDirLengthSquared;
     {
-        epDir = direction(1);
-        double distance = (p[3]-origin).length(); // distance from B
+        T distance = (P[3]-origin).length(); // distance from B
         if (distance < fabs(minDistance)) {
-            minDistance = nonZeroSign(crossProduct(epDir, p[3]-origin))*distance;
-            param = dotProduct(epDir-(p[3]-origin), epDir)/dotProduct(epDir, epDir);
+            minDistance = nonZeroSign(crossProduct(coefficients.bDir, P[3]-origin))*distance;
+            param = dotProduct(coefficients.bDir-(P[3]-origin), coefficients.bDir)/coefficients.bDirLengthSquared;
         }
     }
     // Iterative minimum distance search
-    for (int i = 0; i <= MSDFGEN_CUBIC_SEARCH_STARTS; ++i) {
-        double t = (double) i/MSDFGEN_CUBIC_SEARCH_STARTS;
-        Vector2 qe = qa+3*t*ab+3*t*t*br+t*t*t*as;
-        for (int step = 0; step < MSDFGEN_CUBIC_SEARCH_STEPS; ++step) {
+    for (int i = 0; i <= coefficients.searchStarts; ++i) {
+        T t = T(i)/coefficients.searchStarts;
+        BasicVector2<T> qe = qa+3*t*ab+3*t*t*br+t*t*t*as;
+        for (int step = 0; step < coefficients.searchSteps; ++step) {
             // Improve t
-            Vector2 d1 = 3*ab+6*t*br+3*t*t*as;
-            Vector2 d2 = 6*br+6*t*as;
-            t -= dotProduct(qe, d1)/(dotProduct(d1, d1)+dotProduct(qe, d2));
+            BasicVector2<T> d1 = 3*ab+6*t*br+3*t*t*as;
+            BasicVector2<T> d2 = 6*br+6*t*as;
+            T d1d1 = dotProduct(d1, d1);
+            T dt = dotProduct(qe, d1)/(d1d1+dotProduct(qe, d2));
+            t -= dt;
             if (t <= 0 || t >= 1)
                 break;
             qe = qa+3*t*ab+3*t*t*br+t*t*t*as;
-            double distance = qe.length();
+            T distance = qe.length();
             if (distance < fabs(minDistance)) {
                 minDistance = nonZeroSign(crossProduct(d1, qe))*distance;
                 param = t;
             }
+            // Stop once the step has moved the point by less than the tolerance
+            if (dt*dt*d1d1 < coefficients.squaredSearchTolerance)
+                break;
         }
     }
 
     if (param >= 0 && param <= 1)
-        return SignedDistance(minDistance, 0);
+        return BasicSignedDistance<T>(minDistance, 0);
     if (param < .5)
-        return SignedDistance(minDistance, fabs(dotProduct(direction(0).normalize(), qa.normalize())));
+        return BasicSignedDistance<T>(minDistance, fabs(dotProduct(coefficients.aNormalizedDir, qa.normalize())));
     else
-        return SignedDistance(minDistance, fabs(dotProduct(direction(1).normalize(), (p[3]-origin).normalize())));
+        return BasicSignedDistance<T>(minDistance, fabs(dotProduct(coefficients.bNormalizedDir, (P[3]-origin).normalize())));
+}
+
+void LinearSegment::getCoefficients(EdgeCoefficients &coefficients) const {
+    linearCoefficients(*this, coefficients);
+}
+
+void LinearSegment::getCoefficients(FloatEdgeCoefficients &coefficients) const {
+    linearCoefficients(*this, coefficients);
+}
+
+SignedDistance LinearSegment::signedDistance(const EdgeCoefficients &coefficients, Point2 origin, double &param) {
+    return linearSignedDistance(coefficients, origin, param);
+}
+
+FloatSignedDistance LinearSegment::signedDistance(const FloatEdgeCoefficients &coefficients, FloatPoint2 origin, float &param) {
+    return linearSignedDistance(coefficients, origin, param);
+}
+
+void QuadraticSegment::getCoefficients(EdgeCoefficients &coefficients) const {
+    quadraticCoefficients(*this, coefficients);
+}
+
+void QuadraticSegment::getCoefficients(FloatEdgeCoefficients &coefficients) const {
+    quadraticCoefficients(*this, coefficients);
+}
+
+SignedDistance QuadraticSegment::signedDistance(const EdgeCoefficients &coefficients, Point2 origin, double &param) {
+    return quadraticSignedDistance(coefficients, origin, param);
+}
+
+FloatSignedDistance QuadraticSegment::signedDistance(const FloatEdgeCoefficients &coefficients, FloatPoint2 origin, float &param) {
+    return quadraticSignedDistance(coefficients, origin, param);
+}
+
+void CubicSegment::getCoefficients(EdgeCoefficients &coefficients, double searchTolerance) const {
+    cubicCoefficients(*this, coefficients, searchTolerance);
+}
+
+void CubicSegment::getCoefficients(FloatEdgeCoefficients &coefficients, double searchTolerance) const {
+    cubicCoefficients(*this, coefficients, searchTolerance);
+}
+
+SignedDistance CubicSegment::signedDistance(const EdgeCoefficients &coefficients, Point2 origin, double &param) {
+    return cubicSignedDistance(coefficients, origin, param);
+}
+
+FloatSignedDistance CubicSegment::signedDistance(const FloatEdgeCoefficients &coefficients, FloatPoint2 origin, float &param) {
+    return cubicSignedDistance(coefficients, origin, param);
+}
+
+SignedDistance LinearSegment::signedDistance(Point2 origin, double &param) const {
+    EdgeCoefficients coefficients;
+    getCoefficients(coefficients);
+    return linearSignedDistance(coefficients, origin, param);
+}
+
+FloatSignedDistance LinearSegment::signedDistance(FloatPoint2 origin, float &param) const {
+    FloatEdgeCoefficients coefficients;
+    getCoefficients(coefficients);
+    return linearSignedDistance(coefficients, origin, param);
+}
+
+SignedDistance QuadraticSegment::signedDistance(Point2 origin, double &param) const {
+    EdgeCoefficients coefficients;
+    getCoefficients(coefficients);
+    return quadraticSignedDistance(coefficients, origin, param);
+}
+
+FloatSignedDistance QuadraticSegment::signedDistance(FloatPoint2 origin, float &param) const {
+    FloatEdgeCoefficients coefficients;
+    getCoefficients(coefficients);
+    return quadraticSignedDistance(coefficients, origin, param);
+}
+
+SignedDistance CubicSegment::signedDistance(Point2 origin, double &param) const {
+    EdgeCoefficients coefficients;
+    getCoefficients(coefficients);
+    return cubicSignedDistance(coefficients, origin, param);
+}
+
+FloatSignedDistance CubicSegment::signedDistance(FloatPoint2 origin, float &param) const {
+    FloatEdgeCoefficients coefficients;
+    getCoefficients(coefficients);
+    return cubicSignedDistance(coefficients, origin, param);
 }
 
 int LinearSegment::scanlineIntersections(double x[3], int dy[3], double y) const {
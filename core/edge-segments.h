@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include "Vector2.hpp"
 #include "SignedDistance.hpp"
 #include "EdgeColor.h"
@@ -11,6 +12,31 @@ namespace msdfgen {
 #define MSDFGEN_CUBIC_SEARCH_STARTS 4
 #define MSDFGEN_CUBIC_SEARCH_STEPS 4
 
+/// The quantities of an edge segment that do not depend on the origin of a distance query, which can be precomputed to speed up repeated queries.
+template <typename T>
+struct BasicEdgeCoefficients {
+    /// The control points.
+    BasicVector2<T> p[4];
+    /// The coefficients of the edge's polynomial in the power basis relative to its start point (ab for a line, ab and br for a quadratic curve, ab, br, and as for a cubic curve).
+    BasicVector2<T> ab, br, as;
+    /// The directions of a curve at its endpoints, their squared lengths, and the normalized directions (of a line, only aNormalizedDir is used).
+    BasicVector2<T> aDir, bDir;
+    T aDirLengthSquared, bDirLengthSquared;
+    BasicVector2<T> aNormalizedDir, bNormalizedDir;
+    /// The unit normal of a line and the squared length of ab.
+    BasicVector2<T> orthonormal;
+    T abLengthSquared;
+    /// The coefficients of the cubic equation for the nearest point of a quadratic curve that do not depend on the origin.
+    T a, b, abab2;
+    /// The number of starting points and the maximum number of Newton iterations from each of them of the nearest point search of a cubic curve.
+    int searchStarts, searchSteps;
+    /// The squared length of a step of the nearest point search of a cubic curve, below which the search from its starting point is terminated.
+    T squaredSearchTolerance;
+};
+
+typedef BasicEdgeCoefficients<double> EdgeCoefficients;
+typedef BasicEdgeCoefficients<float> FloatEdgeCoefficients;
+
 /// An abstract edge segment.
 class EdgeSegment {
 
@@ -21,6 +47,11 @@ public:
     static EdgeSegment *create(Point2 p0, Point2 p1, Point2 p2, EdgeColor edgeColor = WHITE);
     static EdgeSegment *create(Point2 p0, Point2 p1, Point2 p2, Point2 p3, EdgeColor edgeColor = WHITE);
 
+    /// Allocates the edge segment from the current EdgeSegmentArena of the thread, or on the heap if there is none.
+    static void *operator new(size_t size);
+    /// Frees the memory of an edge segment allocated on the heap. The memory of edge segments allocated from an arena is freed with the arena.
+    static void operator delete(void *ptr);
+
     EdgeSegment(EdgeColor edgeColor = WHITE) : color(edgeColor) { }
     virtual ~EdgeSegment() { }
     /// Creates a copy of the edge segment.
@@ -37,8 +68,12 @@ public:
     virtual Vector2 directionChange(double param) const = 0;
     /// Returns the minimum signed distance between origin and the edge.
     virtual SignedDistance signedDistance(Point2 origin, double &param) const = 0;
+    /// Returns the minimum signed distance between origin and the edge, computed in single precision.
+    virtual FloatSignedDistance signedDistance(FloatPoint2 origin, float &param) const;
     /// Converts a previously retrieved signed distance from origin to perpendicular distance.
     virtual void distanceToPerpendicularDistance(SignedDistance &distance, Point2 origin, double param) const;
+    /// Converts a previously retrieved single-precision signed distance from origin to perpendicular distance.
+    virtual void distanceToPerpendicularDistance(FloatSignedDistance &distance, FloatPoint2 origin, float param) const;
     /// Outputs a list of (at most three) intersections (their X coordinates) with an infinite horizontal scanline at y and returns how many there are.
     virtual int scanlineIntersections(double x[3], int dy[3], double y) const = 0;
     /// Adjusts the bounding box to fit the edge segment.
@@ -74,6 +109,13 @@ public:
     Vector2 directionChange(double param) const;
     double length() const;
     SignedDistance signedDistance(Point2 origin, double &param) const;
+    FloatSignedDistance signedDistance(FloatPoint2 origin, float &param) const;
+    /// Computes the quantities of the edge segment that do not depend on the origin of a distance query.
+    void getCoefficients(EdgeCoefficients &coefficients) const;
+    void getCoefficients(FloatEdgeCoefficients &coefficients) const;
+    /// Returns the same signed distance as signedDistance for an edge segment of this type with the given precomputed coefficients.
+    static SignedDistance signedDistance(const EdgeCoefficients &coefficients, Point2 origin, double &param);
+    static FloatSignedDistance signedDistance(const FloatEdgeCoefficients &coefficients, FloatPoint2 origin, float &param);
     int scanlineIntersections(double x[3], int dy[3], double y) const;
     void bound(double &l, double &b, double &r, double &t) const;
 
@@ -103,6 +145,13 @@ public:
     Vector2 directionChange(double param) const;
     double length() const;
     SignedDistance signedDistance(Point2 origin, double &param) const;
+    FloatSignedDistance signedDistance(FloatPoint2 origin, float &param) const;
+    /// Computes the quantities of the edge segment that do not depend on the origin of a distance query.
+    void getCoefficients(EdgeCoefficients &coefficients) const;
+    void getCoefficients(FloatEdgeCoefficients &coefficients) const;
+    /// Returns the same signed distance as signedDistance for an edge segment of this type with the given precomputed coefficients.
+    static SignedDistance signedDistance(const EdgeCoefficients &coefficients, Point2 origin, double &param);
+    static FloatSignedDistance signedDistance(const FloatEdgeCoefficients &coefficients, FloatPoint2 origin, float &param);
     int scanlineIntersections(double x[3], int dy[3], double y) const;
     void bound(double &l, double &b, double &r, double &t) const;
 
@@ -133,6 +182,15 @@ public:
     Vector2 direction(double param) const;
     Vector2 directionChange(double param) const;
     SignedDistance signedDistance(Point2 origin, double &param) const;
+    FloatSignedDistance signedDistance(FloatPoint2 origin, float &param) const;
+    /// Computes the quantities of the edge segment that do not depend on the origin of a distance query.
+    /// If searchTolerance is positive, the effort of the nearest point search is adapted to the curve, so that its error is approximately within searchTolerance (in shape units),
+    /// otherwise the search makes the fixed number of iterations given by MSDFGEN_CUBIC_SEARCH_STARTS and MSDFGEN_CUBIC_SEARCH_STEPS, same as signedDistance.
+    void getCoefficients(EdgeCoefficients &coefficients, double searchTolerance = 0) const;
+    void getCoefficients(FloatEdgeCoefficients &coefficients, double searchTolerance = 0) const;
+    /// Returns the same signed distance as signedDistance for an edge segment of this type with the given precomputed coefficients.
+    static SignedDistance signedDistance(const EdgeCoefficients &coefficients, Point2 origin, double &param);
+    static FloatSignedDistance signedDistance(const FloatEdgeCoefficients &coefficients, FloatPoint2 origin, float &param);
     int scanlineIntersections(double x[3], int dy[3], double y) const;
     void bound(double &l, double &b, double &r, double &t) const;
 
@@ -1,47 +1,120 @@
 
 #include "edge-selectors.h"
 
+#include <limits>
 #include "arithmetics.hpp"
 
 namespace msdfgen {
 
 #define DISTANCE_DELTA_FACTOR 1.001
+// Applied to the distance between a group cache's point and its members' points, so that the group test remains conservative after rounding
+#define GROUP_DISTANCE_DELTA_FACTOR (DISTANCE_DELTA_FACTOR*DISTANCE_DELTA_FACTOR)
 
-TrueDistanceSelector::EdgeCache::EdgeCache() : absDistance(0) { }
+template <typename T>
+BasicEdgeGeometry<T>::BasicEdgeGeometry() { }
 
-void TrueDistanceSelector::reset(const Point2 &p) {
-    double delta = DISTANCE_DELTA_FACTOR*(p-this->p).length();
+template <typename T>
+BasicEdgeGeometry<T>::BasicEdgeGeometry(const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge) {
+    a = BasicVector2<T>(edge->point(0));
+    b = BasicVector2<T>(edge->point(1));
+    aDir = BasicVector2<T>(edge->direction(0)).normalize(true);
+    bDir = BasicVector2<T>(edge->direction(1)).normalize(true);
+    BasicVector2<T> prevDir = BasicVector2<T>(prevEdge->direction(1)).normalize(true);
+    BasicVector2<T> nextDir = BasicVector2<T>(nextEdge->direction(0)).normalize(true);
+    aBisector = (prevDir+aDir).normalize(true);
+    bBisector = (bDir+nextDir).normalize(true);
+}
+
+template <typename T>
+BasicTrueDistanceSelector<T>::EdgeCache::EdgeCache() : absDistance(0) { }
+
+template <typename T>
+void BasicTrueDistanceSelector<T>::reset(const Point2 &p) {
+    T delta = DISTANCE_DELTA_FACTOR*(BasicVector2<T>(p)-this->p).length();
     minDistance.distance += nonZeroSign(minDistance.distance)*delta;
-    this->p = p;
-}
-
-void TrueDistanceSelector::addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge) {
-    double delta = DISTANCE_DELTA_FACTOR*(p-cache.point).length();
-    if (cache.absDistance-delta <= fabs(minDistance.distance)) {
-        double dummy;
-        SignedDistance distance = edge->signedDistance(p, dummy);
-        if (distance < minDistance)
-            minDistance = distance;
-        cache.point = p;
-        cache.absDistance = fabs(distance.distance);
+    this->p = BasicVector2<T>(p);
+}
+
+template <typename T>
+bool BasicTrueDistanceSelector<T>::addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge) {
+    if (isEdgeRelevant(cache, edge)) {
+        T param;
+        BasicSignedDistance<T> distance = edge->signedDistance(p, param);
+        addEdge(cache, prevEdge, edge, nextEdge, distance, param);
+        return true;
     }
+    return false;
 }
 
-void TrueDistanceSelector::merge(const TrueDistanceSelector &other) {
+template <typename T>
+bool BasicTrueDistanceSelector<T>::isEdgeRelevant(const EdgeCache &cache, const EdgeSegment *) const {
+    T delta = DISTANCE_DELTA_FACTOR*(p-cache.point).length();
+    return cache.absDistance-delta <= fabs(minDistance.distance);
+}
+
+template <typename T>
+void BasicTrueDistanceSelector<T>::addEdge(EdgeCache &cache, const EdgeSegment *, const EdgeSegment *, const EdgeSegment *, const BasicSignedDistance<T> &distance, T) {
+    if (distance < minDistance)
+        minDistance = distance;
+    cache.point = p;
+    cache.absDistance = fabs(distance.distance);
+}
+
+template <typename T>
+void BasicTrueDistanceSelector<T>::addEdge(EdgeCache &cache, const EdgeSegment *, const BasicEdgeGeometry<T> &, const BasicSignedDistance<T> &distance, T) {
+    if (distance < minDistance)
+        minDistance = distance;
+    cache.point = p;
+    cache.absDistance = fabs(distance.distance);
+}
+
+template <typename T>
+void BasicTrueDistanceSelector<T>::boundDistance(const EdgeSegment *, T distance) {
+    // The bound must exceed the edge's distance, so that the edge (or a nearer one) is still selected.
+    T bound = T(DISTANCE_DELTA_FACTOR*fabs(distance));
+    if (bound > fabs(distance) && bound < fabs(minDistance.distance))
+        minDistance.distance = nonZeroSign(minDistance.distance)*bound;
+}
+
+template <typename T>
+bool BasicTrueDistanceSelector<T>::isGroupRelevant(const GroupCache &cache, const ShapeBVH::Node &node) const {
+    T delta = DISTANCE_DELTA_FACTOR*(p-cache.point).length();
+    return cache.absDistance-delta <= fabs(minDistance.distance) && node.distanceBound(Point2(p)) <= DISTANCE_DELTA_FACTOR*fabs(minDistance.distance);
+}
+
+template <typename T>
+void BasicTrueDistanceSelector<T>::updateGroupCache(GroupCache &groupCache, const EdgeCache *caches, int count) const {
+    groupCache.point = p;
+    groupCache.absDistance = std::numeric_limits<T>::max();
+    for (int i = 0; i < count; ++i) {
+        T absDistance = caches[i].absDistance-GROUP_DISTANCE_DELTA_FACTOR*(p-caches[i].point).length();
+        if (absDistance < groupCache.absDistance)
+            groupCache.absDistance = absDistance;
+    }
+}
+
+template <typename T>
+void BasicTrueDistanceSelector<T>::merge(const BasicTrueDistanceSelector &other) {
     if (other.minDistance < minDistance)
         minDistance = other.minDistance;
 }
 
-TrueDistanceSelector::DistanceType TrueDistanceSelector::distance() const {
+template <typename T>
+typename BasicTrueDistanceSelector<T>::DistanceType BasicTrueDistanceSelector<T>::distance() const {
     return minDistance.distance;
 }
 
-PerpendicularDistanceSelectorBase::EdgeCache::EdgeCache() : absDistance(0), aDomainDistance(0), bDomainDistance(0), aPerpendicularDistance(0), bPerpendicularDistance(0) { }
+template <typename T>
+BasicPerpendicularDistanceSelectorBase<T>::EdgeCache::EdgeCache() : absDistance(0), aDomainDistance(0), bDomainDistance(0), aPerpendicularDistance(0), bPerpendicularDistance(0) { }
 
-bool PerpendicularDistanceSelectorBase::getPerpendicularDistance(double &distance, const Vector2 &ep, const Vector2 &edgeDir) {
-    double ts = dotProduct(ep, edgeDir);
+template <typename T>
+BasicPerpendicularDistanceSelectorBase<T>::GroupCache::GroupCache() : absDistance(0), domainDistance(0), negativePerpendicularDistance(0), positivePerpendicularDistance(0) { }
+
+template <typename T>
+bool BasicPerpendicularDistanceSelectorBase<T>::getPerpendicularDistance(T &distance, const BasicVector2<T> &ep, const BasicVector2<T> &edgeDir) {
+    T ts = dotProduct(ep, edgeDir);
     if (ts > 0) {
-        double perpendicularDistance = crossProduct(ep, edgeDir);
+        T perpendicularDistance = crossProduct(ep, edgeDir);
         if (fabs(perpendicularDistance) < fabs(distance)) {
             distance = perpendicularDistance;
             return true;
@@ -50,9 +123,58 @@ bool PerpendicularDistanceSelectorBase::getPerpendicularDistance(double &distanc
     return false;
 }
 
-PerpendicularDistanceSelectorBase::PerpendicularDistanceSelectorBase() : minNegativePerpendicularDistance(-fabs(minTrueDistance.distance)), minPositivePerpendicularDistance(fabs(minTrueDistance.distance)), nearEdge(NULL), nearEdgeParam(0) { }
+template <class GroupCache, typename T>
+static void addPerpendicularDistanceBound(GroupCache &groupCache, T domainDistance, T perpendicularDistance, T delta) {
+    if (domainDistance > 0) {
+        if (perpendicularDistance < 0) {
+            if (perpendicularDistance+delta > groupCache.negativePerpendicularDistance)
+                groupCache.negativePerpendicularDistance = perpendicularDistance+delta;
+        } else {
+            if (perpendicularDistance-delta < groupCache.positivePerpendicularDistance)
+                groupCache.positivePerpendicularDistance = perpendicularDistance-delta;
+        }
+    }
+}
+
+template <typename T>
+void BasicPerpendicularDistanceSelectorBase<T>::updateGroupCache(GroupCache &groupCache, const EdgeCache *caches, int count, const BasicVector2<T> &p) {
+    groupCache.point = p;
+    groupCache.absDistance = std::numeric_limits<T>::max();
+    groupCache.domainDistance = std::numeric_limits<T>::max();
+    groupCache.negativePerpendicularDistance = -std::numeric_limits<T>::max();
+    groupCache.positivePerpendicularDistance = std::numeric_limits<T>::max();
+    for (int i = 0; i < count; ++i) {
+        const EdgeCache &cache = caches[i];
+        T delta = GROUP_DISTANCE_DELTA_FACTOR*(p-cache.point).length();
+        groupCache.absDistance = min(groupCache.absDistance, cache.absDistance-delta);
+        groupCache.domainDistance = min<T>(groupCache.domainDistance, min(fabs(cache.aDomainDistance), fabs(cache.bDomainDistance))-delta);
+        addPerpendicularDistanceBound(groupCache, cache.aDomainDistance, cache.aPerpendicularDistance, delta);
+        addPerpendicularDistanceBound(groupCache, cache.bDomainDistance, cache.bPerpendicularDistance, delta);
+    }
+}
 
-void PerpendicularDistanceSelectorBase::reset(double delta) {
+template <typename T>
+void BasicPerpendicularDistanceSelectorBase<T>::updateGroupCache(GroupCache &groupCache, const GroupCache *caches, int count, const BasicVector2<T> &p) {
+    groupCache.point = p;
+    groupCache.absDistance = std::numeric_limits<T>::max();
+    groupCache.domainDistance = std::numeric_limits<T>::max();
+    groupCache.negativePerpendicularDistance = -std::numeric_limits<T>::max();
+    groupCache.positivePerpendicularDistance = std::numeric_limits<T>::max();
+    for (int i = 0; i < count; ++i) {
+        const GroupCache &cache = caches[i];
+        T delta = GROUP_DISTANCE_DELTA_FACTOR*(p-cache.point).length();
+        groupCache.absDistance = min(groupCache.absDistance, cache.absDistance-delta);
+        groupCache.domainDistance = min(groupCache.domainDistance, cache.domainDistance-delta);
+        groupCache.negativePerpendicularDistance = max(groupCache.negativePerpendicularDistance, cache.negativePerpendicularDistance+delta);
+        groupCache.positivePerpendicularDistance = min(groupCache.positivePerpendicularDistance, cache.positivePerpendicularDistance-delta);
+    }
+}
+
+template <typename T>
+BasicPerpendicularDistanceSelectorBase<T>::BasicPerpendicularDistanceSelectorBase() : minNegativePerpendicularDistance(-fabs(minTrueDistance.distance)), minPositivePerpendicularDistance(fabs(minTrueDistance.distance)), nearEdge(NULL), nearEdgeParam(0) { }
+
+template <typename T>
+void BasicPerpendicularDistanceSelectorBase<T>::reset(T delta) {
     minTrueDistance.distance += nonZeroSign(minTrueDistance.distance)*delta;
     minNegativePerpendicularDistance = -fabs(minTrueDistance.distance);
     minPositivePerpendicularDistance = fabs(minTrueDistance.distance);
@@ -60,8 +182,9 @@ void PerpendicularDistanceSelectorBase::reset(double delta) {
     nearEdgeParam = 0;
 }
 
-bool PerpendicularDistanceSelectorBase::isEdgeRelevant(const EdgeCache &cache, const EdgeSegment *edge, const Point2 &p) const {
-    double delta = DISTANCE_DELTA_FACTOR*(p-cache.point).length();
+template <typename T>
+bool BasicPerpendicularDistanceSelectorBase<T>::isEdgeRelevant(const EdgeCache &cache, const EdgeSegment *edge, const BasicVector2<T> &p) const {
+    T delta = DISTANCE_DELTA_FACTOR*(p-cache.point).length();
     return (
         cache.absDistance-delta <= fabs(minTrueDistance.distance) ||
         fabs(cache.aDomainDistance) < delta ||
@@ -77,7 +200,19 @@ bool PerpendicularDistanceSelectorBase::isEdgeRelevant(const EdgeCache &cache, c
     );
 }
 
-void PerpendicularDistanceSelectorBase::addEdgeTrueDistance(const EdgeSegment *edge, const SignedDistance &distance, double param) {
+template <typename T>
+bool BasicPerpendicularDistanceSelectorBase<T>::isGroupRelevant(const GroupCache &cache, const BasicVector2<T> &p) const {
+    T delta = DISTANCE_DELTA_FACTOR*(p-cache.point).length();
+    return (
+        cache.absDistance-delta <= fabs(minTrueDistance.distance) ||
+        cache.domainDistance < delta ||
+        cache.negativePerpendicularDistance+delta >= minNegativePerpendicularDistance ||
+        cache.positivePerpendicularDistance-delta <= minPositivePerpendicularDistance
+    );
+}
+
+template <typename T>
+void BasicPerpendicularDistanceSelectorBase<T>::addEdgeTrueDistance(const EdgeSegment *edge, const BasicSignedDistance<T> &distance, T param) {
     if (distance < minTrueDistance) {
         minTrueDistance = distance;
         nearEdge = edge;
@@ -85,14 +220,29 @@ void PerpendicularDistanceSelectorBase::addEdgeTrueDistance(const EdgeSegment *e
     }
 }
 
-void PerpendicularDistanceSelectorBase::addEdgePerpendicularDistance(double distance) {
+template <typename T>
+void BasicPerpendicularDistanceSelectorBase<T>::addEdgePerpendicularDistance(T distance) {
     if (distance <= 0 && distance > minNegativePerpendicularDistance)
         minNegativePerpendicularDistance = distance;
     if (distance >= 0 && distance < minPositivePerpendicularDistance)
         minPositivePerpendicularDistance = distance;
 }
 
-void PerpendicularDistanceSelectorBase::merge(const PerpendicularDistanceSelectorBase &other) {
+template <typename T>
+void BasicPerpendicularDistanceSelectorBase<T>::boundDistance(T distance) {
+    // The bound must exceed the edge's distance, so that the edge (or a nearer one) is still selected. Perpendicular distances beyond it cannot affect the result.
+    T bound = T(DISTANCE_DELTA_FACTOR*fabs(distance));
+    if (bound > fabs(distance) && bound < fabs(minTrueDistance.distance)) {
+        minTrueDistance.distance = nonZeroSign(minTrueDistance.distance)*bound;
+        if (-bound > minNegativePerpendicularDistance)
+            minNegativePerpendicularDistance = -bound;
+        if (bound < minPositivePerpendicularDistance)
+            minPositivePerpendicularDistance = bound;
+    }
+}
+
+template <typename T>
+void BasicPerpendicularDistanceSelectorBase<T>::merge(const BasicPerpendicularDistanceSelectorBase &other) {
     if (other.minTrueDistance < minTrueDistance) {
         minTrueDistance = other.minTrueDistance;
         nearEdge = other.nearEdge;
@@ -104,10 +254,11 @@ void PerpendicularDistanceSelectorBase::merge(const PerpendicularDistanceSelecto
         minPositivePerpendicularDistance = other.minPositivePerpendicularDistance;
 }
 
-double PerpendicularDistanceSelectorBase::computeDistance(const Point2 &p) const {
-    double minDistance = minTrueDistance.distance < 0 ? minNegativePerpendicularDistance : minPositivePerpendicularDistance;
+template <typename T>
+T BasicPerpendicularDistanceSelectorBase<T>::computeDistance(const BasicVector2<T> &p) const {
+    T minDistance = minTrueDistance.distance < 0 ? minNegativePerpendicularDistance : minPositivePerpendicularDistance;
     if (nearEdge) {
-        SignedDistance distance = minTrueDistance;
+        BasicSignedDistance<T> distance = minTrueDistance;
         nearEdge->distanceToPerpendicularDistance(distance, p, nearEdgeParam);
         if (fabs(distance.distance) < fabs(minDistance))
             minDistance = distance.distance;
@@ -115,132 +266,216 @@ double PerpendicularDistanceSelectorBase::computeDistance(const Point2 &p) const
     return minDistance;
 }
 
-SignedDistance PerpendicularDistanceSelectorBase::trueDistance() const {
+template <typename T>
+BasicSignedDistance<T> BasicPerpendicularDistanceSelectorBase<T>::trueDistance() const {
     return minTrueDistance;
 }
 
-void PerpendicularDistanceSelector::reset(const Point2 &p) {
-    double delta = DISTANCE_DELTA_FACTOR*(p-this->p).length();
-    PerpendicularDistanceSelectorBase::reset(delta);
-    this->p = p;
-}
-
-void PerpendicularDistanceSelector::addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge) {
-    if (isEdgeRelevant(cache, edge, p)) {
-        double param;
-        SignedDistance distance = edge->signedDistance(p, param);
-        addEdgeTrueDistance(edge, distance, param);
-        cache.point = p;
-        cache.absDistance = fabs(distance.distance);
-
-        Vector2 ap = p-edge->point(0);
-        Vector2 bp = p-edge->point(1);
-        Vector2 aDir = edge->direction(0).normalize(true);
-        Vector2 bDir = edge->direction(1).normalize(true);
-        Vector2 prevDir = prevEdge->direction(1).normalize(true);
-        Vector2 nextDir = nextEdge->direction(0).normalize(true);
-        double add = dotProduct(ap, (prevDir+aDir).normalize(true));
-        double bdd = -dotProduct(bp, (bDir+nextDir).normalize(true));
-        if (add > 0) {
-            double pd = distance.distance;
-            if (getPerpendicularDistance(pd, ap, -aDir))
-                addEdgePerpendicularDistance(pd = -pd);
-            cache.aPerpendicularDistance = pd;
-        }
-        if (bdd > 0) {
-            double pd = distance.distance;
-            if (getPerpendicularDistance(pd, bp, bDir))
-                addEdgePerpendicularDistance(pd);
-            cache.bPerpendicularDistance = pd;
-        }
-        cache.aDomainDistance = add;
-        cache.bDomainDistance = bdd;
+template <typename T>
+void BasicPerpendicularDistanceSelector<T>::reset(const Point2 &p) {
+    T delta = DISTANCE_DELTA_FACTOR*(BasicVector2<T>(p)-this->p).length();
+    BasicPerpendicularDistanceSelectorBase<T>::reset(delta);
+    this->p = BasicVector2<T>(p);
+}
+
+template <typename T>
+bool BasicPerpendicularDistanceSelector<T>::addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge) {
+    if (isEdgeRelevant(cache, edge)) {
+        T param;
+        BasicSignedDistance<T> distance = edge->signedDistance(p, param);
+        addEdge(cache, prevEdge, edge, nextEdge, distance, param);
+        return true;
     }
+    return false;
+}
+
+template <typename T>
+bool BasicPerpendicularDistanceSelector<T>::isEdgeRelevant(const EdgeCache &cache, const EdgeSegment *edge) const {
+    return BasicPerpendicularDistanceSelectorBase<T>::isEdgeRelevant(cache, edge, p);
 }
 
-PerpendicularDistanceSelector::DistanceType PerpendicularDistanceSelector::distance() const {
-    return computeDistance(p);
+template <typename T>
+void BasicPerpendicularDistanceSelector<T>::addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge, const BasicSignedDistance<T> &distance, T param) {
+    addEdge(cache, edge, BasicEdgeGeometry<T>(prevEdge, edge, nextEdge), distance, param);
 }
 
-void MultiDistanceSelector::reset(const Point2 &p) {
-    double delta = DISTANCE_DELTA_FACTOR*(p-this->p).length();
+template <typename T>
+void BasicPerpendicularDistanceSelector<T>::addEdge(EdgeCache &cache, const EdgeSegment *edge, const BasicEdgeGeometry<T> &geometry, const BasicSignedDistance<T> &distance, T param) {
+    this->addEdgeTrueDistance(edge, distance, param);
+    cache.point = p;
+    cache.absDistance = fabs(distance.distance);
+
+    BasicVector2<T> ap = p-geometry.a;
+    BasicVector2<T> bp = p-geometry.b;
+    T add = dotProduct(ap, geometry.aBisector);
+    T bdd = -dotProduct(bp, geometry.bBisector);
+    if (add > 0) {
+        T pd = distance.distance;
+        if (this->getPerpendicularDistance(pd, ap, -geometry.aDir))
+            this->addEdgePerpendicularDistance(pd = -pd);
+        cache.aPerpendicularDistance = pd;
+    }
+    if (bdd > 0) {
+        T pd = distance.distance;
+        if (this->getPerpendicularDistance(pd, bp, geometry.bDir))
+            this->addEdgePerpendicularDistance(pd);
+        cache.bPerpendicularDistance = pd;
+    }
+    cache.aDomainDistance = add;
+    cache.bDomainDistance = bdd;
+}
+
+template <typename T>
+void BasicPerpendicularDistanceSelector<T>::boundDistance(const EdgeSegment *, T distance) {
+    BasicPerpendicularDistanceSelectorBase<T>::boundDistance(distance);
+}
+
+template <typename T>
+bool BasicPerpendicularDistanceSelector<T>::isGroupRelevant(const GroupCache &cache, const ShapeBVH::Node &) const {
+    return BasicPerpendicularDistanceSelectorBase<T>::isGroupRelevant(cache, p);
+}
+
+template <typename T>
+void BasicPerpendicularDistanceSelector<T>::updateGroupCache(GroupCache &groupCache, const EdgeCache *caches, int count) const {
+    BasicPerpendicularDistanceSelectorBase<T>::updateGroupCache(groupCache, caches, count, p);
+}
+
+template <typename T>
+void BasicPerpendicularDistanceSelector<T>::updateGroupCache(GroupCache &groupCache, const GroupCache *caches, int count) const {
+    BasicPerpendicularDistanceSelectorBase<T>::updateGroupCache(groupCache, caches, count, p);
+}
+
+template <typename T>
+typename BasicPerpendicularDistanceSelector<T>::DistanceType BasicPerpendicularDistanceSelector<T>::distance() const {
+    return this->computeDistance(p);
+}
+
+template <typename T>
+void BasicMultiDistanceSelector<T>::reset(const Point2 &p) {
+    T delta = DISTANCE_DELTA_FACTOR*(BasicVector2<T>(p)-this->p).length();
     r.reset(delta);
     g.reset(delta);
     b.reset(delta);
-    this->p = p;
+    this->p = BasicVector2<T>(p);
 }
 
-void MultiDistanceSelector::addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge) {
-    if (
+template <typename T>
+bool BasicMultiDistanceSelector<T>::addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge) {
+    if (isEdgeRelevant(cache, edge)) {
+        T param;
+        BasicSignedDistance<T> distance = edge->signedDistance(p, param);
+        addEdge(cache, prevEdge, edge, nextEdge, distance, param);
+        return true;
+    }
+    return false;
+}
+
+template <typename T>
+bool BasicMultiDistanceSelector<T>::isEdgeRelevant(const EdgeCache &cache, const EdgeSegment *edge) const {
+    return (
         (edge->color&RED && r.isEdgeRelevant(cache, edge, p)) ||
         (edge->color&GREEN && g.isEdgeRelevant(cache, edge, p)) ||
         (edge->color&BLUE && b.isEdgeRelevant(cache, edge, p))
-    ) {
-        double param;
-        SignedDistance distance = edge->signedDistance(p, param);
-        if (edge->color&RED)
-            r.addEdgeTrueDistance(edge, distance, param);
-        if (edge->color&GREEN)
-            g.addEdgeTrueDistance(edge, distance, param);
-        if (edge->color&BLUE)
-            b.addEdgeTrueDistance(edge, distance, param);
-        cache.point = p;
-        cache.absDistance = fabs(distance.distance);
-
-        Vector2 ap = p-edge->point(0);
-        Vector2 bp = p-edge->point(1);
-        Vector2 aDir = edge->direction(0).normalize(true);
-        Vector2 bDir = edge->direction(1).normalize(true);
-        Vector2 prevDir = prevEdge->direction(1).normalize(true);
-        Vector2 nextDir = nextEdge->direction(0).normalize(true);
-        double add = dotProduct(ap, (prevDir+aDir).normalize(true));
-        double bdd = -dotProduct(bp, (bDir+nextDir).normalize(true));
-        if (add > 0) {
-            double pd = distance.distance;
-            if (PerpendicularDistanceSelectorBase::getPerpendicularDistance(pd, ap, -aDir)) {
-                pd = -pd;
-                if (edge->color&RED)
-                    r.addEdgePerpendicularDistance(pd);
-                if (edge->color&GREEN)
-                    g.addEdgePerpendicularDistance(pd);
-                if (edge->color&BLUE)
-                    b.addEdgePerpendicularDistance(pd);
-            }
-            cache.aPerpendicularDistance = pd;
+    );
+}
+
+template <typename T>
+void BasicMultiDistanceSelector<T>::addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge, const BasicSignedDistance<T> &distance, T param) {
+    addEdge(cache, edge, BasicEdgeGeometry<T>(prevEdge, edge, nextEdge), distance, param);
+}
+
+template <typename T>
+void BasicMultiDistanceSelector<T>::addEdge(EdgeCache &cache, const EdgeSegment *edge, const BasicEdgeGeometry<T> &geometry, const BasicSignedDistance<T> &distance, T param) {
+    if (edge->color&RED)
+        r.addEdgeTrueDistance(edge, distance, param);
+    if (edge->color&GREEN)
+        g.addEdgeTrueDistance(edge, distance, param);
+    if (edge->color&BLUE)
+        b.addEdgeTrueDistance(edge, distance, param);
+    cache.point = p;
+    cache.absDistance = fabs(distance.distance);
+
+    BasicVector2<T> ap = p-geometry.a;
+    BasicVector2<T> bp = p-geometry.b;
+    T add = dotProduct(ap, geometry.aBisector);
+    T bdd = -dotProduct(bp, geometry.bBisector);
+    if (add > 0) {
+        T pd = distance.distance;
+        if (BasicPerpendicularDistanceSelectorBase<T>::getPerpendicularDistance(pd, ap, -geometry.aDir)) {
+            pd = -pd;
+            if (edge->color&RED)
+                r.addEdgePerpendicularDistance(pd);
+            if (edge->color&GREEN)
+                g.addEdgePerpendicularDistance(pd);
+            if (edge->color&BLUE)
+                b.addEdgePerpendicularDistance(pd);
         }
-        if (bdd > 0) {
-            double pd = distance.distance;
-            if (PerpendicularDistanceSelectorBase::getPerpendicularDistance(pd, bp, bDir)) {
-                if (edge->color&RED)
-                    r.addEdgePerpendicularDistance(pd);
-                if (edge->color&GREEN)
-                    g.addEdgePerpendicularDistance(pd);
-                if (edge->color&BLUE)
-                    b.addEdgePerpendicularDistance(pd);
-            }
-            cache.bPerpendicularDistance = pd;
+        cache.aPerpendicularDistance = pd;
+    }
+    if (bdd > 0) {
+        T pd = distance.distance;
+        if (BasicPerpendicularDistanceSelectorBase<T>::getPerpendicularDistance(pd, bp, geometry.bDir)) {
+            if (edge->color&RED)
+                r.addEdgePerpendicularDistance(pd);
+            if (edge->color&GREEN)
+                g.addEdgePerpendicularDistance(pd);
+            if (edge->color&BLUE)
+                b.addEdgePerpendicularDistance(pd);
         }
-        cache.aDomainDistance = add;
-        cache.bDomainDistance = bdd;
+        cache.bPerpendicularDistance = pd;
     }
+    cache.aDomainDistance = add;
+    cache.bDomainDistance = bdd;
+}
+
+template <typename T>
+void BasicMultiDistanceSelector<T>::boundDistance(const EdgeSegment *edge, T distance) {
+    if (edge->color&RED)
+        r.boundDistance(distance);
+    if (edge->color&GREEN)
+        g.boundDistance(distance);
+    if (edge->color&BLUE)
+        b.boundDistance(distance);
+}
+
+template <typename T>
+bool BasicMultiDistanceSelector<T>::isGroupRelevant(const GroupCache &cache, const ShapeBVH::Node &node) const {
+    return (
+        (node.color&RED && r.isGroupRelevant(cache, p)) ||
+        (node.color&GREEN && g.isGroupRelevant(cache, p)) ||
+        (node.color&BLUE && b.isGroupRelevant(cache, p))
+    );
 }
 
-void MultiDistanceSelector::merge(const MultiDistanceSelector &other) {
+template <typename T>
+void BasicMultiDistanceSelector<T>::updateGroupCache(GroupCache &groupCache, const EdgeCache *caches, int count) const {
+    BasicPerpendicularDistanceSelectorBase<T>::updateGroupCache(groupCache, caches, count, p);
+}
+
+template <typename T>
+void BasicMultiDistanceSelector<T>::updateGroupCache(GroupCache &groupCache, const GroupCache *caches, int count) const {
+    BasicPerpendicularDistanceSelectorBase<T>::updateGroupCache(groupCache, caches, count, p);
+}
+
+template <typename T>
+void BasicMultiDistanceSelector<T>::merge(const BasicMultiDistanceSelector &other) {
     r.merge(other.r);
     g.merge(other.g);
     b.merge(other.b);
 }
 
-MultiDistanceSelector::DistanceType MultiDistanceSelector::distance() const {
-    MultiDistance multiDistance;
+template <typename T>
+typename BasicMultiDistanceSelector<T>::DistanceType BasicMultiDistanceSelector<T>::distance() const {
+    BasicMultiDistance<T> multiDistance;
     multiDistance.r = r.computeDistance(p);
     multiDistance.g = g.computeDistance(p);
     multiDistance.b = b.computeDistance(p);
     return multiDistance;
 }
 
-SignedDistance MultiDistanceSelector::trueDistance() const {
-    SignedDistance distance = r.trueDistance();
+template <typename T>
+BasicSignedDistance<T> BasicMultiDistanceSelector<T>::trueDistance() const {
+    BasicSignedDistance<T> distance = r.trueDistance();
     if (g.trueDistance() < distance)
         distance = g.trueDistance();
     if (b.trueDistance() < distance)
@@ -248,14 +483,28 @@ SignedDistance MultiDistanceSelector::trueDistance() const {
     return distance;
 }
 
-MultiAndTrueDistanceSelector::DistanceType MultiAndTrueDistanceSelector::distance() const {
-    MultiDistance multiDistance = MultiDistanceSelector::distance();
-    MultiAndTrueDistance mtd;
+template <typename T>
+typename BasicMultiAndTrueDistanceSelector<T>::DistanceType BasicMultiAndTrueDistanceSelector<T>::distance() const {
+    BasicMultiDistance<T> multiDistance = BasicMultiDistanceSelector<T>::distance();
+    BasicMultiAndTrueDistance<T> mtd;
     mtd.r = multiDistance.r;
     mtd.g = multiDistance.g;
     mtd.b = multiDistance.b;
-    mtd.a = trueDistance().distance;
+    mtd.a = this->trueDistance().distance;
     return mtd;
 }
 
+template struct BasicEdgeGeometry<double>;
+template struct BasicEdgeGeometry<float>;
+template class BasicTrueDistanceSelector<double>;
+template class BasicTrueDistanceSelector<float>;
+template class BasicPerpendicularDistanceSelectorBase<double>;
+template class BasicPerpendicularDistanceSelectorBase<float>;
+template class BasicPerpendicularDistanceSelector<double>;
+template class BasicPerpendicularDistanceSelector<float>;
+template class BasicMultiDistanceSelector<double>;
+template class BasicMultiDistanceSelector<float>;
+template class BasicMultiAndTrueDistanceSelector<double>;
+template class BasicMultiAndTrueDistanceSelector<float>;
+
 }
@@ -4,114 +4,201 @@
 #include "Vector2.hpp"
 #include "SignedDistance.hpp"
 #include "edge-segments.h"
+#include "ShapeBVH.h"
 
 namespace msdfgen {
 
-struct MultiDistance {
-    double r, g, b;
+template <typename T>
+struct BasicMultiDistance {
+    T r, g, b;
 };
-struct MultiAndTrueDistance : MultiDistance {
-    double a;
+template <typename T>
+struct BasicMultiAndTrueDistance : BasicMultiDistance<T> {
+    T a;
 };
 
+typedef BasicMultiDistance<double> MultiDistance;
+typedef BasicMultiAndTrueDistance<double> MultiAndTrueDistance;
+
+/// The geometry of an edge and its neighbors in a contour used by the edge selectors, which can be precomputed for each edge (see CompiledShape).
+template <typename T>
+struct BasicEdgeGeometry {
+    /// The endpoints of the edge.
+    BasicVector2<T> a, b;
+    /// The normalized directions of the edge at its endpoints.
+    BasicVector2<T> aDir, bDir;
+    /// The normalized bisectors of the directions at the edge's corners with the previous and the next edge.
+    BasicVector2<T> aBisector, bBisector;
+
+    BasicEdgeGeometry();
+    BasicEdgeGeometry(const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge);
+};
+
+typedef BasicEdgeGeometry<double> EdgeGeometry;
+typedef BasicEdgeGeometry<float> FloatEdgeGeometry;
+
+// The edge selectors below are templated on the scalar type T (double or float) of their distance computations.
+
 /// Selects the nearest edge by its true distance.
-class TrueDistanceSelector {
+template <typename T>
+class BasicTrueDistanceSelector {
 
 public:
-    typedef double DistanceType;
+    typedef T ScalarType;
+    typedef T DistanceType;
 
     struct EdgeCache {
-        Point2 point;
-        double absDistance;
+        BasicVector2<T> point;
+        T absDistance;
 
         EdgeCache();
     };
+    /// Summarizes the edge caches of a group of edges so that the whole group may be skipped.
+    typedef EdgeCache GroupCache;
 
     void reset(const Point2 &p);
-    void addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge);
-    void merge(const TrueDistanceSelector &other);
+    /// Computes the distance to the edge and adds it unless the cache shows that it cannot affect the result. Returns whether the distance was computed.
+    bool addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge);
+    /// Returns false if the edge cannot affect the result, so that its distance need not be computed.
+    bool isEdgeRelevant(const EdgeCache &cache, const EdgeSegment *edge) const;
+    /// Adds an edge whose signed distance (and the corresponding param) from the current point has already been computed.
+    void addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge, const BasicSignedDistance<T> &distance, T param);
+    /// Same as above with the edge's precomputed geometry in place of its neighbors.
+    void addEdge(EdgeCache &cache, const EdgeSegment *edge, const BasicEdgeGeometry<T> &geometry, const BasicSignedDistance<T> &distance, T param);
+    /// Limits the selected distance to slightly more than the distance of edge from the current point, so that farther edges are skipped. Does not affect the result.
+    void boundDistance(const EdgeSegment *edge, T distance);
+    /// Returns false if none of the edges of the ShapeBVH node summarized by cache can affect the result.
+    bool isGroupRelevant(const GroupCache &cache, const ShapeBVH::Node &node) const;
+    /// Updates the cache of a group from the caches of its edges or subgroups.
+    void updateGroupCache(GroupCache &groupCache, const EdgeCache *caches, int count) const;
+    void merge(const BasicTrueDistanceSelector &other);
     DistanceType distance() const;
 
 private:
-    Point2 p;
-    SignedDistance minDistance;
+    BasicVector2<T> p;
+    BasicSignedDistance<T> minDistance;
 
 };
 
-class PerpendicularDistanceSelectorBase {
+template <typename T>
+class BasicPerpendicularDistanceSelectorBase {
 
 public:
+    typedef T ScalarType;
+
     struct EdgeCache {
-        Point2 point;
-        double absDistance;
-        double aDomainDistance, bDomainDistance;
-        double aPerpendicularDistance, bPerpendicularDistance;
+        BasicVector2<T> point;
+        T absDistance;
+        T aDomainDistance, bDomainDistance;
+        T aPerpendicularDistance, bPerpendicularDistance;
 
         EdgeCache();
     };
+    /// Summarizes the edge caches of a group of edges so that the whole group may be skipped.
+    struct GroupCache {
+        BasicVector2<T> point;
+        T absDistance;
+        T domainDistance;
+        T negativePerpendicularDistance, positivePerpendicularDistance;
+
+        GroupCache();
+    };
 
-    static bool getPerpendicularDistance(double &distance, const Vector2 &ep, const Vector2 &edgeDir);
-
-    PerpendicularDistanceSelectorBase();
-    void reset(double delta);
-    bool isEdgeRelevant(const EdgeCache &cache, const EdgeSegment *edge, const Point2 &p) const;
-    void addEdgeTrueDistance(const EdgeSegment *edge, const SignedDistance &distance, double param);
-    void addEdgePerpendicularDistance(double distance);
-    void merge(const PerpendicularDistanceSelectorBase &other);
-    double computeDistance(const Point2 &p) const;
-    SignedDistance trueDistance() const;
+    static bool getPerpendicularDistance(T &distance, const BasicVector2<T> &ep, const BasicVector2<T> &edgeDir);
+    static void updateGroupCache(GroupCache &groupCache, const EdgeCache *caches, int count, const BasicVector2<T> &p);
+    static void updateGroupCache(GroupCache &groupCache, const GroupCache *caches, int count, const BasicVector2<T> &p);
+
+    BasicPerpendicularDistanceSelectorBase();
+    void reset(T delta);
+    bool isEdgeRelevant(const EdgeCache &cache, const EdgeSegment *edge, const BasicVector2<T> &p) const;
+    bool isGroupRelevant(const GroupCache &cache, const BasicVector2<T> &p) const;
+    void addEdgeTrueDistance(const EdgeSegment *edge, const BasicSignedDistance<T> &distance, T param);
+    void addEdgePerpendicularDistance(T distance);
+    void boundDistance(T distance);
+    void merge(const BasicPerpendicularDistanceSelectorBase &other);
+    T computeDistance(const BasicVector2<T> &p) const;
+    BasicSignedDistance<T> trueDistance() const;
 
 private:
-    SignedDistance minTrueDistance;
-    double minNegativePerpendicularDistance;
-    double minPositivePerpendicularDistance;
+    BasicSignedDistance<T> minTrueDistance;
+    T minNegativePerpendicularDistance;
+    T minPositivePerpendicularDistance;
     const EdgeSegment *nearEdge;
-    double nearEdgeParam;
+    T nearEdgeParam;
 
 };
 
 /// Selects the nearest edge by its perpendicular distance.
-class PerpendicularDistanceSelector : public PerpendicularDistanceSelectorBase {
+template <typename T>
+class BasicPerpendicularDistanceSelector : public BasicPerpendicularDistanceSelectorBase<T> {
 
 public:
-    typedef double DistanceType;
+    typedef T DistanceType;
+    typedef typename BasicPerpendicularDistanceSelectorBase<T>::EdgeCache EdgeCache;
+    typedef typename BasicPerpendicularDistanceSelectorBase<T>::GroupCache GroupCache;
 
     void reset(const Point2 &p);
-    void addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge);
+    using BasicPerpendicularDistanceSelectorBase<T>::isEdgeRelevant;
+    bool addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge);
+    bool isEdgeRelevant(const EdgeCache &cache, const EdgeSegment *edge) const;
+    void addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge, const BasicSignedDistance<T> &distance, T param);
+    void addEdge(EdgeCache &cache, const EdgeSegment *edge, const BasicEdgeGeometry<T> &geometry, const BasicSignedDistance<T> &distance, T param);
+    void boundDistance(const EdgeSegment *edge, T distance);
+    bool isGroupRelevant(const GroupCache &cache, const ShapeBVH::Node &node) const;
+    void updateGroupCache(GroupCache &groupCache, const EdgeCache *caches, int count) const;
+    void updateGroupCache(GroupCache &groupCache, const GroupCache *caches, int count) const;
     DistanceType distance() const;
 
 private:
-    Point2 p;
+    BasicVector2<T> p;
 
 };
 
 /// Selects the nearest edge for each of the three channels by its perpendicular distance.
-class MultiDistanceSelector {
+template <typename T>
+class BasicMultiDistanceSelector {
 
 public:
-    typedef MultiDistance DistanceType;
-    typedef PerpendicularDistanceSelectorBase::EdgeCache EdgeCache;
+    typedef T ScalarType;
+    typedef BasicMultiDistance<T> DistanceType;
+    typedef typename BasicPerpendicularDistanceSelectorBase<T>::EdgeCache EdgeCache;
+    typedef typename BasicPerpendicularDistanceSelectorBase<T>::GroupCache GroupCache;
 
     void reset(const Point2 &p);
-    void addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge);
-    void merge(const MultiDistanceSelector &other);
+    bool addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge);
+    bool isEdgeRelevant(const EdgeCache &cache, const EdgeSegment *edge) const;
+    void addEdge(EdgeCache &cache, const EdgeSegment *prevEdge, const EdgeSegment *edge, const EdgeSegment *nextEdge, const BasicSignedDistance<T> &distance, T param);
+    void addEdge(EdgeCache &cache, const EdgeSegment *edge, const BasicEdgeGeometry<T> &geometry, const BasicSignedDistance<T> &distance, T param);
+    /// Limits the selected distances of the channels of edge's color.
+    void boundDistance(const EdgeSegment *edge, T distance);
+    bool isGroupRelevant(const GroupCache &cache, const ShapeBVH::Node &node) const;
+    void updateGroupCache(GroupCache &groupCache, const EdgeCache *caches, int count) const;
+    void updateGroupCache(GroupCache &groupCache, const GroupCache *caches, int count) const;
+    void merge(const BasicMultiDistanceSelector &other);
     DistanceType distance() const;
-    SignedDistance trueDistance() const;
+    BasicSignedDistance<T> trueDistance() const;
 
 private:
-    Point2 p;
-    PerpendicularDistanceSelectorBase r, g, b;
+    BasicVector2<T> p;
+    BasicPerpendicularDistanceSelectorBase<T> r, g, b;
 
 };
 
 /// Selects the nearest edge for each of the three color channels by its perpendicular distance and by true distance for the alpha channel.
-class MultiAndTrueDistanceSelector : public MultiDistanceSelector {
+template <typename T>
+class BasicMultiAndTrueDistanceSelector : public BasicMultiDistanceSelector<T> {
 
 public:
-    typedef MultiAndTrueDistance DistanceType;
+    typedef BasicMultiAndTrueDistance<T> DistanceType;
 
     DistanceType distance() const;
 
 };
 
+typedef BasicTrueDistanceSelector<double> TrueDistanceSelector;
+typedef BasicPerpendicularDistanceSelectorBase<double> PerpendicularDistanceSelectorBase;
+typedef BasicPerpendicularDistanceSelector<double> PerpendicularDistanceSelector;
+typedef BasicMultiDistanceSelector<double> MultiDistanceSelector;
+typedef BasicMultiAndTrueDistanceSelector<double> MultiAndTrueDistanceSelector;
+
 }
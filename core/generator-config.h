@@ -2,6 +2,7 @@
 #pragma once
 
 #include "BitmapRef.hpp"
+#include "Scanline.h"
 
 #ifndef MSDFGEN_PUBLIC
 #define MSDFGEN_PUBLIC // for DLL import/export
@@ -40,18 +41,61 @@ struct ErrorCorrectionConfig {
     double minDeviationRatio;
     /// The minimum ratio between the pre-correction distance error and the post-correction distance error. Has no effect for DO_NOT_CHECK_DISTANCE.
     double minImproveRatio;
-    /// An optional buffer to avoid dynamic allocation. Must have at least as many bytes as the MSDF has pixels.
+    /// An optional buffer to avoid dynamic allocation. Must have at least as many bytes as the MSDF (or the corrected region including its halo) has pixels.
     byte *buffer;
+    /// When only a region of the MSDF is corrected, the number of texels around the region that are taken into account. A halo of one texel makes adjacent regions stitch together exactly as if the whole MSDF was corrected at once.
+    int halo;
 
-    inline explicit ErrorCorrectionConfig(Mode mode = EDGE_PRIORITY, DistanceCheckMode distanceCheckMode = CHECK_DISTANCE_AT_EDGE, double minDeviationRatio = defaultMinDeviationRatio, double minImproveRatio = defaultMinImproveRatio, byte *buffer = NULL) : mode(mode), distanceCheckMode(distanceCheckMode), minDeviationRatio(minDeviationRatio), minImproveRatio(minImproveRatio), buffer(buffer) { }
+    inline explicit ErrorCorrectionConfig(Mode mode = EDGE_PRIORITY, DistanceCheckMode distanceCheckMode = CHECK_DISTANCE_AT_EDGE, double minDeviationRatio = defaultMinDeviationRatio, double minImproveRatio = defaultMinImproveRatio, byte *buffer = NULL) : mode(mode), distanceCheckMode(distanceCheckMode), minDeviationRatio(minDeviationRatio), minImproveRatio(minImproveRatio), buffer(buffer), halo(1) { }
+};
+
+/// Counters of the distance finder's work, which show how effectively the per-edge caches skip distance computations.
+struct EdgeCacheStatistics {
+    /// The number of distance queries.
+    unsigned long long queryCount;
+    /// The number of edges whose distance was computed.
+    unsigned long long evaluatedEdgeCount;
+    /// The number of edges that were skipped because their cache showed that they could not affect the result.
+    unsigned long long skippedEdgeCount;
+
+    inline EdgeCacheStatistics() : queryCount(0), evaluatedEdgeCount(0), skippedEdgeCount(0) { }
 };
 
 /// The configuration of the distance field generator algorithm.
 struct GeneratorConfig {
     /// Specifies whether to use the version of the algorithm that supports overlapping contours with the same winding. May be set to false to improve performance when no such contours are present.
     bool overlapSupport;
+    /// Specifies whether to build a bounding volume hierarchy of the shape's edges, which allows distant groups of edges to be skipped. Does not affect the output. Improves performance for shapes with many edges, mainly for true distance fields.
+    bool bvhAcceleration;
+    /// Specifies whether to compute distances in single precision instead of double precision. Halves the memory footprint of the per-edge caches, and the loss of precision is negligible for small distance fields with a narrow range.
+    bool singlePrecision;
+    /// The maximum number of threads used by the generator if it is built with a threading backend (MSDFGEN_USE_THREADS or MSDFGEN_USE_OPENMP). Zero selects the backend's default, which is the number of hardware threads.
+    int threadCount;
+    /// The order in which the pixels of each tile of the distance field are evaluated. Orders in which subsequent pixels are closer together make the per-edge caches more effective. Does not affect the output, except for rare ties between equidistant edges.
+    enum TraversalOrder {
+        /// Row by row, alternating the direction of the rows.
+        SERPENTINE,
+        /// Along a Z-order (Morton) curve.
+        MORTON,
+        /// Along a Hilbert curve, where each pixel is adjacent to the previous one.
+        HILBERT
+    } traversalOrder;
+    /// Specifies whether to skip the exact evaluation of pixels of true signed distance fields (generateSDF) that are provably outside the distance range. These are set to exactly 0 or 1 as if the output was clamped, with the sign determined by the non-zero fill rule, while the other pixels are unaffected. Greatly improves performance for small distance ranges.
+    bool narrowBand;
+    /// If positive, true signed distance fields (generateSDF) are generated adaptively, evaluating exactly only the corners of blocks which are then filled by bilinear interpolation where its error is proven to be at most this value (in units of the output pixel values), and subdivided elsewhere. Takes precedence over narrowBand. Greatly improves performance for large distance fields that are mostly smooth.
+    double adaptiveTolerance;
+    /// If positive, the effort of the nearest point search on cubic curves is chosen for each curve so that its error is approximately within this tolerance (in output pixels) instead of the fixed number of iterations given by MSDFGEN_CUBIC_SEARCH_STARTS and MSDFGEN_CUBIC_SEARCH_STEPS. Improves performance for shapes made of cubic curves, such as CFF fonts.
+    double cubicSearchTolerance;
+    /// Specifies whether to determine the signs of the distances by fillRule using a scanline of each row while the pixels are generated, with the same result as a subsequent distanceSignCorrection. Needed for shapes with self-intersecting contours. The error correction of multi-channel distance fields then does not check the shape's distances.
+    bool signCorrection;
+    /// The fill rule of the sign correction.
+    FillRule fillRule;
+    /// If not null, the statistics of the generator's distance queries are added to it.
+    EdgeCacheStatistics *edgeCacheStatistics;
+    /// If not null, a buffer with an element for each pixel of the output (in the same order), into which the index of the nearest edge found for the pixel is written, with the edges of all contours numbered consecutively, or -1 if the pixel was not evaluated exactly. The error correction of multi-channel distance fields with the same configuration uses it to skip edges when checking the shape's distances, which does not affect the result.
+    int *nearestEdges;
 
-    inline explicit GeneratorConfig(bool overlapSupport = true) : overlapSupport(overlapSupport) { }
+    inline explicit GeneratorConfig(bool overlapSupport = true) : overlapSupport(overlapSupport), bvhAcceleration(false), singlePrecision(false), threadCount(0), traversalOrder(SERPENTINE), narrowBand(false), adaptiveTolerance(0), cubicSearchTolerance(0), signCorrection(false), fillRule(FILL_NONZERO), edgeCacheStatistics(NULL), nearestEdges(NULL) { }
 };
 
 /// The configuration of the multi-channel distance field generator algorithm.
@@ -1,16 +1,16 @@
 
 #include "msdf-error-correction.h"
 
+#include <cstring>
 #include <vector>
 #include "arithmetics.hpp"
 #include "Bitmap.h"
-#include "contour-combiners.h"
 #include "MSDFErrorCorrection.h"
 
 namespace msdfgen {
 
-template <int N>
-static void msdfErrorCorrectionInner(const BitmapRef<float, N> &sdf, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config) {
+template <typename T, int N>
+static void msdfErrorCorrectionInner(const BitmapRef<T, N> &sdf, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config) {
     if (config.errorCorrection.mode == ErrorCorrectionConfig::DISABLED)
         return;
     Bitmap<byte, 1> stencilBuffer;
@@ -20,32 +20,67 @@ static void msdfErrorCorrectionInner(const BitmapRef<float, N> &sdf, const Shape
     stencil.pixels = config.errorCorrection.buffer ? config.errorCorrection.buffer : (byte *) stencilBuffer;
     stencil.width = sdf.width, stencil.height = sdf.height;
     MSDFErrorCorrection ec(stencil, transformation);
-    ec.setMinDeviationRatio(config.errorCorrection.minDeviationRatio);
-    ec.setMinImproveRatio(config.errorCorrection.minImproveRatio);
-    switch (config.errorCorrection.mode) {
-        case ErrorCorrectionConfig::DISABLED:
-        case ErrorCorrectionConfig::INDISCRIMINATE:
-            break;
-        case ErrorCorrectionConfig::EDGE_PRIORITY:
-            ec.protectCorners(shape);
-            ec.protectEdges<N>(sdf);
-            break;
-        case ErrorCorrectionConfig::EDGE_ONLY:
-            ec.protectAll();
-            break;
-    }
-    if (config.errorCorrection.distanceCheckMode == ErrorCorrectionConfig::DO_NOT_CHECK_DISTANCE || (config.errorCorrection.distanceCheckMode == ErrorCorrectionConfig::CHECK_DISTANCE_AT_EDGE && config.errorCorrection.mode != ErrorCorrectionConfig::EDGE_ONLY)) {
-        ec.findErrors<N>(sdf);
-        if (config.errorCorrection.distanceCheckMode == ErrorCorrectionConfig::CHECK_DISTANCE_AT_EDGE)
-            ec.protectAll();
+    if (config.nearestEdges)
+        ec.setNearestEdges(BitmapConstRef<int, 1>(config.nearestEdges, sdf.width, sdf.height));
+    ec.findErrors<N>(sdf, shape, config);
+    ec.apply(sdf);
+}
+
+template <typename T, int N>
+static void msdfSectionErrorCorrectionInner(const BitmapRef<T, N> &section, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &sectionRegion, BitmapRegion region, int height, const MSDFGeneratorConfig &config, const BitmapConstRef<int, 1> &nearestEdges = BitmapConstRef<int, 1>()) {
+    if (config.errorCorrection.mode == ErrorCorrectionConfig::DISABLED)
+        return;
+    region = region.clamp(sectionRegion.x1, sectionRegion.y1);
+    if (region.x0 < sectionRegion.x0)
+        region.x0 = sectionRegion.x0;
+    if (region.y0 < sectionRegion.y0)
+        region.y0 = sectionRegion.y0;
+    if (region.empty())
+        return;
+    Bitmap<byte, 1> stencilBuffer;
+    if (!config.errorCorrection.buffer)
+        stencilBuffer = Bitmap<byte, 1>(section.width, section.height);
+    BitmapRef<byte, 1> stencil;
+    stencil.pixels = config.errorCorrection.buffer ? config.errorCorrection.buffer : (byte *) stencilBuffer;
+    stencil.width = section.width, stencil.height = section.height;
+    MSDFErrorCorrection ec(stencil, transformation);
+    ec.setSectionOffset(sectionRegion.x0, sectionRegion.y0, height);
+    ec.setNearestEdges(nearestEdges);
+    ec.findErrors<N>(section, shape, config);
+    // Only apply the correction within the region, the halo texels were not evaluated with all of their neighbors.
+    for (int y = region.y0; y < region.y1; ++y) {
+        const byte *mask = stencil(region.x0-sectionRegion.x0, y-sectionRegion.y0);
+        T *texel = section(region.x0-sectionRegion.x0, y-sectionRegion.y0);
+        for (int x = region.x0; x < region.x1; ++x) {
+            if (*mask&MSDFErrorCorrection::ERROR) {
+                T m = median(texel[0], texel[1], texel[2]);
+                texel[0] = m, texel[1] = m, texel[2] = m;
+            }
+            ++mask;
+            texel += N;
+        }
     }
-    if (config.errorCorrection.distanceCheckMode == ErrorCorrectionConfig::ALWAYS_CHECK_DISTANCE || config.errorCorrection.distanceCheckMode == ErrorCorrectionConfig::CHECK_DISTANCE_AT_EDGE) {
-        if (config.overlapSupport)
-            ec.findErrors<OverlappingContourCombiner, N>(sdf, shape);
-        else
-            ec.findErrors<SimpleContourCombiner, N>(sdf, shape);
+}
+
+template <typename T, int N>
+static void msdfErrorCorrectionInner(const BitmapRef<T, N> &sdf, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config) {
+    if (config.errorCorrection.mode == ErrorCorrectionConfig::DISABLED)
+        return;
+    BitmapRegion clampedRegion = region.clamp(sdf.width, sdf.height);
+    if (clampedRegion.empty())
+        return;
+    if (clampedRegion.x0 == 0 && clampedRegion.y0 == 0 && clampedRegion.x1 == sdf.width && clampedRegion.y1 == sdf.height) {
+        msdfErrorCorrectionInner(sdf, shape, transformation, config);
+        return;
     }
-    ec.apply(sdf);
+    BitmapRegion sectionRegion = clampedRegion.expand(max(config.errorCorrection.halo, 0)).clamp(sdf.width, sdf.height);
+    // The region is corrected in a copy of its section so that the halo texels are not affected by a previously corrected adjacent region.
+    Bitmap<T, N> section(sectionRegion.x1-sectionRegion.x0, sectionRegion.y1-sectionRegion.y0);
+    for (int y = sectionRegion.y0; y < sectionRegion.y1; ++y)
+        memcpy(section(0, y-sectionRegion.y0), sdf(sectionRegion.x0, y), sizeof(T)*N*section.width());
+    msdfSectionErrorCorrectionInner<T, N>(section, shape, transformation, sectionRegion, clampedRegion, sdf.height, config, BitmapConstRef<int, 1>(config.nearestEdges, sdf.width, sdf.height));
+    for (int y = clampedRegion.y0; y < clampedRegion.y1; ++y)
+        memcpy(sdf(clampedRegion.x0, y), section(clampedRegion.x0-sectionRegion.x0, y-sectionRegion.y0), sizeof(T)*N*(clampedRegion.x1-clampedRegion.x0));
 }
 
 template <int N>
@@ -72,6 +107,60 @@ void msdfErrorCorrection(const BitmapRef<float, 4> &sdf, const Shape &shape, con
     msdfErrorCorrectionInner(sdf, shape, SDFTransformation(projection, range), config);
 }
 
+void msdfErrorCorrection(const BitmapRef<float, 3> &sdf, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config) {
+    msdfErrorCorrectionInner(sdf, shape, transformation, region, config);
+}
+void msdfErrorCorrection(const BitmapRef<float, 4> &sdf, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config) {
+    msdfErrorCorrectionInner(sdf, shape, transformation, region, config);
+}
+
+void msdfSectionErrorCorrection(const BitmapRef<float, 3> &section, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &sectionRegion, const BitmapRegion &region, int height, const MSDFGeneratorConfig &config) {
+    msdfSectionErrorCorrectionInner(section, shape, transformation, sectionRegion, region, height, config);
+}
+void msdfSectionErrorCorrection(const BitmapRef<float, 4> &section, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &sectionRegion, const BitmapRegion &region, int height, const MSDFGeneratorConfig &config) {
+    msdfSectionErrorCorrectionInner(section, shape, transformation, sectionRegion, region, height, config);
+}
+
+void msdfErrorCorrection(const BitmapRef<byte, 3> &sdf, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config) {
+    msdfErrorCorrectionInner(sdf, shape, transformation, config);
+}
+void msdfErrorCorrection(const BitmapRef<byte, 3> &sdf, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config) {
+    msdfErrorCorrectionInner(sdf, shape, transformation, region, config);
+}
+void msdfSectionErrorCorrection(const BitmapRef<byte, 3> &section, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &sectionRegion, const BitmapRegion &region, int height, const MSDFGeneratorConfig &config) {
+    msdfSectionErrorCorrectionInner(section, shape, transformation, sectionRegion, region, height, config);
+}
+
+void msdfErrorCorrection(const BitmapRef<byte, 4> &sdf, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config) {
+    msdfErrorCorrectionInner(sdf, shape, transformation, config);
+}
+void msdfErrorCorrection(const BitmapRef<byte, 4> &sdf, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config) {
+    msdfErrorCorrectionInner(sdf, shape, transformation, region, config);
+}
+void msdfSectionErrorCorrection(const BitmapRef<byte, 4> &section, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &sectionRegion, const BitmapRegion &region, int height, const MSDFGeneratorConfig &config) {
+    msdfSectionErrorCorrectionInner(section, shape, transformation, sectionRegion, region, height, config);
+}
+
+void msdfErrorCorrection(const BitmapRef<uint16, 3> &sdf, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config) {
+    msdfErrorCorrectionInner(sdf, shape, transformation, config);
+}
+void msdfErrorCorrection(const BitmapRef<uint16, 3> &sdf, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config) {
+    msdfErrorCorrectionInner(sdf, shape, transformation, region, config);
+}
+void msdfSectionErrorCorrection(const BitmapRef<uint16, 3> &section, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &sectionRegion, const BitmapRegion &region, int height, const MSDFGeneratorConfig &config) {
+    msdfSectionErrorCorrectionInner(section, shape, transformation, sectionRegion, region, height, config);
+}
+
+void msdfErrorCorrection(const BitmapRef<uint16, 4> &sdf, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config) {
+    msdfErrorCorrectionInner(sdf, shape, transformation, config);
+}
+void msdfErrorCorrection(const BitmapRef<uint16, 4> &sdf, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config) {
+    msdfErrorCorrectionInner(sdf, shape, transformation, region, config);
+}
+void msdfSectionErrorCorrection(const BitmapRef<uint16, 4> &section, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &sectionRegion, const BitmapRegion &region, int height, const MSDFGeneratorConfig &config) {
+    msdfSectionErrorCorrectionInner(section, shape, transformation, sectionRegion, region, height, config);
+}
+
 void msdfFastDistanceErrorCorrection(const BitmapRef<float, 3> &sdf, const SDFTransformation &transformation, double minDeviationRatio) {
     msdfErrorCorrectionShapeless(sdf, transformation, minDeviationRatio, false);
 }
@@ -17,6 +17,28 @@ void msdfErrorCorrection(const BitmapRef<float, 4> &sdf, const Shape &shape, con
 void msdfErrorCorrection(const BitmapRef<float, 3> &sdf, const Shape &shape, const Projection &projection, Range range, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
 void msdfErrorCorrection(const BitmapRef<float, 4> &sdf, const Shape &shape, const Projection &projection, Range range, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
 
+/// Corrects only the texels within the region of the MSDF. The texels within the halo around the region (see ErrorCorrectionConfig::halo) are read, and must not have been corrected yet.
+void msdfErrorCorrection(const BitmapRef<float, 3> &sdf, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void msdfErrorCorrection(const BitmapRef<float, 4> &sdf, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+
+/// Corrects the region of an MSDF with the given height that is stored only partially in section, which covers sectionRegion of the MSDF including the region's halo.
+void msdfSectionErrorCorrection(const BitmapRef<float, 3> &section, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &sectionRegion, const BitmapRegion &region, int height, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void msdfSectionErrorCorrection(const BitmapRef<float, 4> &section, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &sectionRegion, const BitmapRegion &region, int height, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+
+/// Corrects MSDFs quantized into 8-bit or 16-bit pixels, taking into account the values as they will be sampled.
+void msdfErrorCorrection(const BitmapRef<byte, 3> &sdf, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void msdfErrorCorrection(const BitmapRef<byte, 4> &sdf, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void msdfErrorCorrection(const BitmapRef<uint16, 3> &sdf, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void msdfErrorCorrection(const BitmapRef<uint16, 4> &sdf, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void msdfErrorCorrection(const BitmapRef<byte, 3> &sdf, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void msdfErrorCorrection(const BitmapRef<byte, 4> &sdf, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void msdfErrorCorrection(const BitmapRef<uint16, 3> &sdf, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void msdfErrorCorrection(const BitmapRef<uint16, 4> &sdf, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void msdfSectionErrorCorrection(const BitmapRef<byte, 3> &section, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &sectionRegion, const BitmapRegion &region, int height, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void msdfSectionErrorCorrection(const BitmapRef<byte, 4> &section, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &sectionRegion, const BitmapRegion &region, int height, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void msdfSectionErrorCorrection(const BitmapRef<uint16, 3> &section, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &sectionRegion, const BitmapRegion &region, int height, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void msdfSectionErrorCorrection(const BitmapRef<uint16, 4> &section, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &sectionRegion, const BitmapRegion &region, int height, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+
 /// Applies the simplified error correction to all discontiunous distances (INDISCRIMINATE mode). Does not need shape or translation.
 void msdfFastDistanceErrorCorrection(const BitmapRef<float, 3> &sdf, const SDFTransformation &transformation, double minDeviationRatio = ErrorCorrectionConfig::defaultMinDeviationRatio);
 void msdfFastDistanceErrorCorrection(const BitmapRef<float, 4> &sdf, const SDFTransformation &transformation, double minDeviationRatio = ErrorCorrectionConfig::defaultMinDeviationRatio);
@@ -1,137 +1,1005 @@
 
 #include "../msdfgen.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
 #include <vector>
 #include "edge-selectors.h"
 #include "contour-combiners.h"
 #include "ShapeDistanceFinder.h"
+#include "MSDFErrorCorrection.h"
+#include "ThreadPool.h"
 
 namespace msdfgen {
 
-template <typename DistanceType>
-class DistancePixelConversion;
-
-template <>
-class DistancePixelConversion<double> {
+template <typename T, typename DistanceType>
+class DistancePixelConversion {
     DistanceMapping mapping;
 public:
-    typedef BitmapRef<float, 1> BitmapRefType;
+    typedef BitmapRef<T, 1> BitmapRefType;
     inline explicit DistancePixelConversion(DistanceMapping mapping) : mapping(mapping) { }
-    inline void operator()(float *pixels, double distance) const {
-        *pixels = float(mapping(distance));
+    inline void operator()(T *pixels, DistanceType distance) const {
+        *pixels = pixelFromFloat<T>(float(mapping(distance)));
+    }
+    /// Converts the distance with the sign given by fill like distanceSignCorrection. A single-channel pixel always matches.
+    inline void operator()(T *pixels, DistanceType distance, bool fill, char &match) const {
+        float sd = float(mapping(distance));
+        *pixels = pixelFromFloat<T>((sd > .5f) != fill ? 1.f-sd : sd);
+        match = 1;
     }
 };
 
-template <>
-class DistancePixelConversion<MultiDistance> {
+/// Converts the multi-channel distance with the sign given by fill like distanceSignCorrection. Sets match to 1 if the sign was kept, -1 if inverted, and 0 if the median is ambiguous.
+template <typename T>
+static void convertSignCorrectedPixel(T *pixels, float *msd, int n, bool fill, char &match) {
+    float sd = median(msd[0], msd[1], msd[2]);
+    if (sd == .5f)
+        match = 0;
+    else if ((sd > .5f) != fill) {
+        msd[0] = 1.f-msd[0];
+        msd[1] = 1.f-msd[1];
+        msd[2] = 1.f-msd[2];
+        match = -1;
+    } else
+        match = 1;
+    if (n >= 4 && (msd[3] > .5f) != fill)
+        msd[3] = 1.f-msd[3];
+    for (int i = 0; i < n; ++i)
+        pixels[i] = pixelFromFloat<T>(msd[i]);
+}
+
+template <typename T, typename S>
+class DistancePixelConversion<T, BasicMultiDistance<S> > {
     DistanceMapping mapping;
 public:
-    typedef BitmapRef<float, 3> BitmapRefType;
+    typedef BitmapRef<T, 3> BitmapRefType;
     inline explicit DistancePixelConversion(DistanceMapping mapping) : mapping(mapping) { }
-    inline void operator()(float *pixels, const MultiDistance &distance) const {
-        pixels[0] = float(mapping(distance.r));
-        pixels[1] = float(mapping(distance.g));
-        pixels[2] = float(mapping(distance.b));
+    inline void operator()(T *pixels, const BasicMultiDistance<S> &distance) const {
+        pixels[0] = pixelFromFloat<T>(float(mapping(distance.r)));
+        pixels[1] = pixelFromFloat<T>(float(mapping(distance.g)));
+        pixels[2] = pixelFromFloat<T>(float(mapping(distance.b)));
+    }
+    inline void operator()(T *pixels, const BasicMultiDistance<S> &distance, bool fill, char &match) const {
+        float msd[3] = { float(mapping(distance.r)), float(mapping(distance.g)), float(mapping(distance.b)) };
+        convertSignCorrectedPixel(pixels, msd, 3, fill, match);
     }
 };
 
-template <>
-class DistancePixelConversion<MultiAndTrueDistance> {
+template <typename T, typename S>
+class DistancePixelConversion<T, BasicMultiAndTrueDistance<S> > {
     DistanceMapping mapping;
 public:
-    typedef BitmapRef<float, 4> BitmapRefType;
+    typedef BitmapRef<T, 4> BitmapRefType;
     inline explicit DistancePixelConversion(DistanceMapping mapping) : mapping(mapping) { }
-    inline void operator()(float *pixels, const MultiAndTrueDistance &distance) const {
-        pixels[0] = float(mapping(distance.r));
-        pixels[1] = float(mapping(distance.g));
-        pixels[2] = float(mapping(distance.b));
-        pixels[3] = float(mapping(distance.a));
+    inline void operator()(T *pixels, const BasicMultiAndTrueDistance<S> &distance) const {
+        pixels[0] = pixelFromFloat<T>(float(mapping(distance.r)));
+        pixels[1] = pixelFromFloat<T>(float(mapping(distance.g)));
+        pixels[2] = pixelFromFloat<T>(float(mapping(distance.b)));
+        pixels[3] = pixelFromFloat<T>(float(mapping(distance.a)));
+    }
+    inline void operator()(T *pixels, const BasicMultiAndTrueDistance<S> &distance, bool fill, char &match) const {
+        float msd[4] = { float(mapping(distance.r)), float(mapping(distance.g)), float(mapping(distance.b)), float(mapping(distance.a)) };
+        convertSignCorrectedPixel(pixels, msd, 4, fill, match);
     }
 };
 
-template <class ContourCombiner>
-void generateDistanceField(const typename DistancePixelConversion<typename ContourCombiner::DistanceType>::BitmapRefType &output, const Shape &shape, const SDFTransformation &transformation) {
-    DistancePixelConversion<typename ContourCombiner::DistanceType> distancePixelConversion(transformation.distanceMapping);
-#ifdef MSDFGEN_USE_OPENMP
-    #pragma omp parallel
-#endif
-    {
-        ShapeDistanceFinder<ContourCombiner> distanceFinder(shape);
-        bool rightToLeft = false;
-#ifdef MSDFGEN_USE_OPENMP
-        #pragma omp for
-#endif
-        for (int y = 0; y < output.height; ++y) {
-            int row = shape.inverseYAxis ? output.height-y-1 : y;
-            for (int col = 0; col < output.width; ++col) {
-                int x = rightToLeft ? output.width-col-1 : col;
-                Point2 p = transformation.unproject(Point2(x+.5, y+.5));
+/// Relative margin by which a pixel must be proven to lie beyond the band of the distance range to be skipped by the narrow band optimization, which absorbs rounding errors.
+#define NARROW_BAND_MARGIN (1./1024.)
+
+/// The size of the blocks of adaptive refinement whose pixels are all evaluated exactly instead of being tested for interpolation.
+#define ADAPTIVE_MIN_BLOCK_SIZE 2
+/// The number of intervals at which the derivative of a cubic curve is sampled to bound its curvature.
+#define CUBIC_CURVATURE_SAMPLES 16
+
+/// Provides the signed distances as scalars for the narrow band optimization and adaptive refinement if EdgeSelector computes true distances, which cannot change by more than the distance between two points.
+template <class EdgeSelector>
+struct TrueDistance {
+    static const bool supported = false;
+    static inline double value(const typename EdgeSelector::DistanceType &) { return 0; }
+};
+
+template <typename T>
+struct TrueDistance<BasicTrueDistanceSelector<T> > {
+    static const bool supported = true;
+    static inline double value(T distance) { return distance; }
+};
+
+/// Computes an upper bound of the curvature of the edge, which is DBL_MAX if its derivative may vanish.
+static double curvatureBound(const EdgeSegment *edge) {
+    const Point2 *p = edge->controlPoints();
+    switch (edge->type()) {
+        case QuadraticSegment::EDGE_TYPE: {
+            // The derivative is linear and its cross product with the constant second derivative is constant.
+            Vector2 d0 = p[1]-p[0], d1 = p[2]-p[1];
+            Vector2 dd = d1-d0;
+            double t = dd.squaredLength() > 0 ? clamp(-dotProduct(d0, dd)/dd.squaredLength()) : 0.;
+            double minDerivative = 2*(d0+t*dd).length();
+            if (minDerivative <= 0)
+                return DBL_MAX;
+            return 4*fabs(crossProduct(d0, d1))/(minDerivative*minDerivative*minDerivative);
+        }
+        case CubicSegment::EDGE_TYPE: {
+            // The derivative is sampled and the bound of the second derivative limits how much it can shrink between the samples.
+            Vector2 d0 = p[1]-p[0], d1 = p[2]-p[1], d2 = p[3]-p[2];
+            double maxSecondDerivative = 6*max((d1-d0).length(), (d2-d1).length());
+            double minDerivative = DBL_MAX;
+            for (int i = 0; i <= CUBIC_CURVATURE_SAMPLES; ++i) {
+                double t = double(i)/CUBIC_CURVATURE_SAMPLES;
+                minDerivative = min(minDerivative, (3*((1-t)*(1-t))*d0+6*(t*(1-t))*d1+3*(t*t)*d2).length());
+            }
+            minDerivative -= .5/CUBIC_CURVATURE_SAMPLES*maxSecondDerivative;
+            if (minDerivative <= 0)
+                return DBL_MAX;
+            return maxSecondDerivative/(minDerivative*minDerivative);
+        }
+    }
+    return 0;
+}
+
+/// Computes the coordinates of the point at index along the Z-order (Morton) curve.
+static void mortonCurvePoint(int index, int &x, int &y) {
+    x = 0, y = 0;
+    for (int bit = 0; index>>2*bit; ++bit) {
+        x |= (index>>2*bit&1)<<bit;
+        y |= (index>>(2*bit+1)&1)<<bit;
+    }
+}
+
+/// Computes the coordinates of the point at index along the Hilbert curve that fills a square of size (a power of two).
+static void hilbertCurvePoint(int size, int index, int &x, int &y) {
+    x = 0, y = 0;
+    for (int s = 1; s < size; s *= 2, index /= 4) {
+        int rx = index>>1&1;
+        int ry = (index^rx)&1;
+        if (!ry) {
+            if (rx) {
+                x = s-1-x;
+                y = s-1-y;
+            }
+            int t = x;
+            x = y, y = t;
+        }
+        x += s*rx;
+        y += s*ry;
+    }
+}
+
+/// Computes the scanline of the shape at the center of each row of pixels starting at yBegin. Each worker sweeps its rows with its own cursor.
+class ScanlineJob {
+
+public:
+    class Worker {
+    public:
+        inline explicit Worker(ScanlineJob &job) : job(job), cursor(job.sweep) { }
+        inline void operator()(int i) {
+            cursor.scanline(job.scanlines[i], job.yBegin+i+.5);
+        }
+    private:
+        ScanlineJob &job;
+        ScanlineSweep::Cursor cursor;
+    };
+
+    inline ScanlineJob(std::vector<Scanline> &scanlines, const Shape &shape, const SDFTransformation &transformation, int yBegin, int yEnd) : scanlines(scanlines), sweep(shape, transformation, yEnd), yBegin(yBegin) { }
+
+private:
+    std::vector<Scanline> &scanlines;
+    ScanlineSweep sweep;
+    int yBegin;
+
+};
+
+/**
+ * Generates a region of a distance field split into square tiles. The pixels of each tile are traversed in the configured order by a worker with its own distance finder.
+ * In narrow band mode, each exactly evaluated distance d proves that pixels closer than |d|-bandRadius lie outside the distance range,
+ * so they are set to 0 or 1 without being evaluated. Their sign is determined by the non-zero fill rule using the shape's scanline at their row,
+ * inverted if the shape's orientation is reversed, i.e., its distance is positive far outside.
+ * With sign correction, the sign of each pixel is determined by the fill rule using the scanline of its row as it is written, like distanceSignCorrection does afterwards.
+ * Multi-channel pixels whose median is ambiguous are resolved by their neighbors once the whole region is generated.
+ * In adaptive mode, each tile is recursively subdivided into square blocks, whose corners are evaluated exactly. A block is filled by bilinear interpolation
+ * if a single edge is the nearest one in the whole block and the bound of the distance's second derivative given by its curvature limits the interpolation error to the tolerance.
+ */
+template <typename T, class ContourCombiner>
+class DistanceFieldGenerationJob {
+
+public:
+    typedef typename DistancePixelConversion<T, typename ContourCombiner::DistanceType>::BitmapRefType BitmapRefType;
+
+    class Worker {
+    public:
+        inline explicit Worker(DistanceFieldGenerationJob &job) : job(job), distanceFinder(job.shape, &job.compiledShape, job.bvh), saturationRadius(0), tileIndex(-1), tileY(0) { }
+        void operator()(int tile) {
+            int xBegin, yBegin, xEnd, yEnd;
+            job.tileBounds(tile, xBegin, yBegin, xEnd, yEnd);
+            if (!job.tileStatistics.empty())
+                distanceFinder.resetStatistics();
+            // Each tile starts from the same state, so that its pixels do not depend on which tiles were processed by the worker before.
+            distanceFinder.resetCache();
+            saturationRadius = 0;
+            tileIndex = tile;
+            tileY = yBegin;
+            for (int i = 0; i < MSDFGEN_PARALLEL_TILE_SIZE; ++i)
+                scanlineIndices[i] = 0;
+            if (job.interpolationTolerance > 0) {
+                const int size = MSDFGEN_PARALLEL_TILE_SIZE;
+                tileXEnd = xEnd, tileYEnd = yEnd;
+                refineBlock(xBegin, yBegin, size, sampleDistance(xBegin, yBegin), sampleDistance(xBegin+size, yBegin), sampleDistance(xBegin, yBegin+size), sampleDistance(xBegin+size, yBegin+size));
+            } else switch (job.traversalOrder) {
+                case GeneratorConfig::MORTON:
+                case GeneratorConfig::HILBERT:
+                    // Follow the curve across the whole tile and skip the pixels outside the (possibly partial) tile.
+                    for (int i = 0; i < MSDFGEN_PARALLEL_TILE_SIZE*MSDFGEN_PARALLEL_TILE_SIZE; ++i) {
+                        int x, y;
+                        if (job.traversalOrder == GeneratorConfig::HILBERT)
+                            hilbertCurvePoint(MSDFGEN_PARALLEL_TILE_SIZE, i, x, y);
+                        else
+                            mortonCurvePoint(i, x, y);
+                        x += xBegin, y += yBegin;
+                        if (x < xEnd && y < yEnd)
+                            generatePixel(x, y);
+                    }
+                    break;
+                default: {
+                    bool rightToLeft = false;
+                    for (int y = yBegin; y < yEnd; ++y) {
+                        for (int col = xBegin; col < xEnd; ++col)
+                            generatePixel(rightToLeft ? xBegin+xEnd-col-1 : col, y);
+                        rightToLeft = !rightToLeft;
+                    }
+                }
+            }
+            if (!job.tileStatistics.empty())
+                job.tileStatistics[tile] = distanceFinder.getStatistics();
+        }
+    private:
+        DistanceFieldGenerationJob &job;
+        ShapeDistanceFinder<ContourCombiner> distanceFinder;
+        /// The last exactly evaluated point and the distance by which it is proven that the points around it are outside the distance range.
+        Point2 saturationCenter;
+        double saturationRadius;
+        int tileIndex, tileY;
+        /// The positions of the last queries of the job's scanlines of the rows of the current tile.
+        int scanlineIndices[MSDFGEN_PARALLEL_TILE_SIZE];
+        /// In adaptive mode, the end of the current (possibly partial) tile, beyond which blocks are only sampled.
+        int tileXEnd, tileYEnd;
+
+        /// The edges that can be the nearest ones within a block, which must be of the same contour.
+        struct NearestEdges {
+            int count;
+            int contourIndex;
+            int edgeIndices[2];
+            double distances[2];
+            double maxDistance;
+        };
+
+        /// Decides whether the shape is filled at x in row y of the current tile.
+        inline bool filled(double x, int y, FillRule fillRule) {
+            return job.scanlines[y-job.yBegin].filled(x, fillRule, scanlineIndices[y-tileY]);
+        }
+
+        inline void generatePixel(int x, int y) {
+            int row = job.shape.inverseYAxis ? job.height-y-1 : y;
+            Point2 p = job.transformation.unproject(Point2(x+.5, y+.5));
+            T *pixel = job.output(x-job.offsetX, row-job.offsetY);
+            if (job.bandRadius > 0) {
+                if (saturationRadius-(p-saturationCenter).length() > job.bandRadius) {
+                    float sd = job.saturatedValues[filled(p.x, y, FILL_NONZERO) != job.reverseOrientation];
+                    if (job.signCorrection && (sd > .5f) != filled(p.x, y, job.fillRule))
+                        sd = 1.f-sd;
+                    *pixel = pixelFromFloat<T>(sd);
+                    setNearestEdge(x, row, -1);
+                    return;
+                }
                 typename ContourCombiner::DistanceType distance = distanceFinder.distance(p);
-                distancePixelConversion(output(x, row), distance);
+                writePixel(pixel, x, y, row, p, distance);
+                setNearestEdge(x, row, distanceFinder.nearestEdge());
+                saturationCenter = p;
+                // The selected distance may be that of a contour farther than the nearest edge if contours overlap, so only the distance of the nearest edge bounds the distances around p.
+                saturationRadius = (1-NARROW_BAND_MARGIN)*distanceFinder.edgeDistanceBound();
+                return;
+            }
+            typename ContourCombiner::DistanceType distance = distanceFinder.distance(p);
+            writePixel(pixel, x, y, row, p, distance);
+            setNearestEdge(x, row, distanceFinder.nearestEdge());
+        }
+
+        /// Records the nearest edge of pixel x in the given row if the job outputs the nearest edges.
+        inline void setNearestEdge(int x, int row, int edgeIndex) {
+            if (job.nearestEdges)
+                job.nearestEdges[x-job.offsetX+job.output.width*(row-job.offsetY)] = edgeIndex;
+        }
+
+        /// Converts the distance at point p of pixel (x, y) into the output pixel, resolving its sign if sign correction is enabled.
+        inline void writePixel(T *pixel, int x, int y, int row, const Point2 &p, const typename ContourCombiner::DistanceType &distance) {
+            if (job.signCorrection) {
+                char &match = job.matchMap[x-job.offsetX+job.output.width*(row-job.offsetY)];
+                job.distancePixelConversion(pixel, distance, filled(p.x, y, job.fillRule), match);
+                if (!match)
+                    job.ambiguousTiles[tileIndex] = true;
+            } else
+                job.distancePixelConversion(pixel, distance);
+        }
+
+        /// Computes the exact signed distance at the center of pixel (x, y), which may lie outside the current tile.
+        inline double sampleDistance(int x, int y) {
+            return TrueDistance<typename ContourCombiner::EdgeSelectorType>::value(distanceFinder.distance(job.transformation.unproject(Point2(x+.5, y+.5))));
+        }
+
+        inline void setPixel(int x, int y, double distance) {
+            int row = job.shape.inverseYAxis ? job.height-y-1 : y;
+            float sd = float(job.transformation.distanceMapping(distance));
+            if (job.signCorrection && (sd > .5f) != filled(job.transformation.unprojectX(x+.5), y, job.fillRule))
+                sd = 1.f-sd;
+            *job.output(x-job.offsetX, row-job.offsetY) = pixelFromFloat<T>(sd);
+            setNearestEdge(x, row, -1);
+        }
+
+        /// Fills the pixels of the current tile within the block at (x0, y0) of the given size, whose corner pixels (including the ones outside the block) have the distances d00 to d11.
+        void refineBlock(int x0, int y0, int size, double d00, double d10, double d01, double d11) {
+            if (x0 >= tileXEnd || y0 >= tileYEnd)
+                return;
+            int xEnd = min(x0+size, tileXEnd), yEnd = min(y0+size, tileYEnd);
+            if (size <= ADAPTIVE_MIN_BLOCK_SIZE) {
+                for (int y = y0; y < yEnd; ++y) {
+                    for (int x = x0; x < xEnd; ++x)
+                        setPixel(x, y, x == x0 && y == y0 ? d00 : sampleDistance(x, y));
+                }
+                return;
+            }
+            int half = size/2;
+            double dmm = sampleDistance(x0+half, y0+half);
+            if (isInterpolable(x0, y0, size, d00, d10, d01, d11, dmm)) {
+                for (int y = y0; y < yEnd; ++y) {
+                    double ty = double(y-y0)/size;
+                    double left = mix(d00, d01, ty), right = mix(d10, d11, ty);
+                    for (int x = x0; x < xEnd; ++x)
+                        setPixel(x, y, mix(left, right, double(x-x0)/size));
+                }
+                return;
+            }
+            double dm0 = sampleDistance(x0+half, y0);
+            double d0m = sampleDistance(x0, y0+half);
+            double d1m = sampleDistance(x0+size, y0+half);
+            double dm1 = sampleDistance(x0+half, y0+size);
+            refineBlock(x0, y0, half, d00, dm0, d0m, dmm);
+            refineBlock(x0+half, y0, half, dm0, d10, dmm, d1m);
+            refineBlock(x0, y0+half, half, d0m, dmm, d01, dm1);
+            refineBlock(x0+half, y0+half, half, dmm, d1m, dm1, d11);
+        }
+
+        /// Determines whether bilinear interpolation of the corner distances d00 to d11 of the block is proven to be within the tolerance everywhere in it. dmm is the distance at its center.
+        bool isInterpolable(int x0, int y0, int size, double d00, double d10, double d01, double d11, double dmm) const {
+            Vector2 blockX = job.transformation.unprojectVector(Vector2(size, 0));
+            Vector2 blockY = job.transformation.unprojectVector(Vector2(0, size));
+            double blockRadius = .5*sqrt(blockX.squaredLength()+blockY.squaredLength());
+            Point2 center = job.transformation.unproject(Point2(x0+.5*size+.5, y0+.5*size+.5));
+            // An edge can only be the nearest one somewhere in the block if its distance from the center is within the block's diameter of the minimum, which is at most |dmm|.
+            NearestEdges nearest;
+            nearest.count = 0;
+            nearest.maxDistance = fabs(dmm)+2*blockRadius;
+            for (int i = 0; i < (int) job.shape.contours.size(); ++i) {
+                int root = job.edgeHierarchy.contourRoot(i);
+                if (root >= 0 && !findNearestEdges(nearest, i, root, center))
+                    return false;
+            }
+            const double cornerDistances[4] = { d00, d10, d01, d11 };
+            double secondDerivative;
+            if (nearest.count == 1) {
+                // The distance is that of the interior of a single edge. Its second derivative at distance d from a curve with curvature k is at most k/(1-k*d) until the center of curvature is reached.
+                const EdgeSegment *edge = job.shape.contours[nearest.contourIndex].edges[nearest.edgeIndices[0]];
+                double curvature = job.edgeCurvatures[job.contourEdgeOffsets[nearest.contourIndex]+nearest.edgeIndices[0]];
+                double maxDistance = nearest.distances[0]+blockRadius;
+                if (curvature*maxDistance >= 1)
+                    return false;
+                secondDerivative = curvature/(1-curvature*maxDistance);
+                // The corner distances must be the edge's own, i.e., not altered by the contour combiner, and not be measured from its endpoints.
+                for (int i = 0; i < 4; ++i) {
+                    double param;
+                    SignedDistance distance = edge->signedDistance(job.transformation.unproject(Point2(x0+size*(i&1)+.5, y0+size*(i>>1)+.5)), param);
+                    if (!(param > 0 && param < 1) || fabs(distance.distance-cornerDistances[i]) > .5*job.interpolationTolerance)
+                        return false;
+                }
+            } else if (nearest.count == 2) {
+                // The distance is that of the vertex shared by two consecutive edges, whose second derivative at distance d is at most 1/d.
+                const std::vector<EdgeHolder> &edges = job.shape.contours[nearest.contourIndex].edges;
+                int n = (int) edges.size();
+                int prevEdge = nearest.edgeIndices[0], nextEdge = nearest.edgeIndices[1];
+                if ((prevEdge+1)%n != nextEdge)
+                    std::swap(prevEdge, nextEdge);
+                if ((prevEdge+1)%n != nextEdge)
+                    return false;
+                Point2 vertex = edges[nextEdge]->point(0);
+                double minDistance = (center-vertex).length()-blockRadius;
+                if (minDistance <= 0)
+                    return false;
+                secondDerivative = 1/minDistance;
+                // The vertex must be the nearest point of both edges and the corner distances must not be altered by the contour combiner.
+                for (int i = 0; i < 4; ++i) {
+                    Point2 corner = job.transformation.unproject(Point2(x0+size*(i&1)+.5, y0+size*(i>>1)+.5));
+                    double prevParam, nextParam;
+                    edges[prevEdge]->signedDistance(corner, prevParam);
+                    edges[nextEdge]->signedDistance(corner, nextParam);
+                    if (prevParam < 1 || nextParam > 0 || (cornerDistances[i] > 0) != (dmm > 0) || fabs(fabs(cornerDistances[i])-(corner-vertex).length()) > .5*job.interpolationTolerance)
+                        return false;
+                }
+            } else
+                return false;
+            return .125*secondDerivative*(blockX.squaredLength()+blockY.squaredLength()) <= job.interpolationTolerance;
+        }
+
+        /// Collects the edges of the contour's hierarchy node within nearest.maxDistance of p. Returns false if there are more than two such edges or they belong to different contours.
+        bool findNearestEdges(NearestEdges &nearest, int contourIndex, int nodeIndex, Point2 p) const {
+            const ShapeBVH::Node &node = job.edgeHierarchy[nodeIndex];
+            if (node.distanceBound(p) > nearest.maxDistance)
+                return true;
+            if (node.children >= 0)
+                return findNearestEdges(nearest, contourIndex, node.children, p) && findNearestEdges(nearest, contourIndex, node.children+1, p);
+            const std::vector<EdgeHolder> &edges = job.shape.contours[contourIndex].edges;
+            int n = (int) edges.size();
+            for (int i = node.begin; i < node.end; ++i) {
+                int edgeIndex = (i+n-1)%n;
+                double param;
+                double distance = fabs(edges[edgeIndex]->signedDistance(p, param).distance);
+                if (distance <= nearest.maxDistance) {
+                    if (nearest.count == 2 || (nearest.count == 1 && nearest.contourIndex != contourIndex))
+                        return false;
+                    nearest.contourIndex = contourIndex;
+                    nearest.edgeIndices[nearest.count] = edgeIndex;
+                    nearest.distances[nearest.count] = distance;
+                    ++nearest.count;
+                }
+            }
+            return true;
+        }
+    };
+
+    inline DistanceFieldGenerationJob(const BitmapRefType &output, const Shape &shape, const SDFTransformation &transformation, const ShapeBVH *bvh, const BitmapRegion &region, int offsetX, int offsetY, int height, GeneratorConfig::TraversalOrder traversalOrder, bool narrowBand, double adaptiveTolerance, double cubicSearchTolerance, bool signCorrection, FillRule fillRule, int *nearestEdges, bool collectStatistics) :
+        output(output), shape(shape), transformation(transformation), distancePixelConversion(transformation.distanceMapping), bvh(bvh), region(region), offsetX(offsetX), offsetY(offsetY), height(height), traversalOrder(traversalOrder), bandRadius(0), reverseOrientation(false), signCorrection(signCorrection), fillRule(fillRule), nearestEdges(nearestEdges), interpolationTolerance(0) {
+        if (cubicSearchTolerance > 0) {
+            // Convert the tolerance from pixels to shape units in the direction where it is smaller.
+            Vector2 tolerance = transformation.unprojectVector(Vector2(cubicSearchTolerance));
+            cubicSearchTolerance = min(fabs(tolerance.x), fabs(tolerance.y));
+        }
+        compiledShape.build(shape, cubicSearchTolerance);
+        if (adaptiveTolerance > 0 && TrueDistance<typename ContourCombiner::EdgeSelectorType>::supported) {
+            DistanceMapping inverseMapping = transformation.distanceMapping.inverse();
+            interpolationTolerance = fabs(inverseMapping(adaptiveTolerance)-inverseMapping(0.));
+            edgeHierarchy.build(shape);
+            for (std::vector<Contour>::const_iterator contour = shape.contours.begin(); contour != shape.contours.end(); ++contour) {
+                contourEdgeOffsets.push_back((int) edgeCurvatures.size());
+                for (std::vector<EdgeHolder>::const_iterator edge = contour->edges.begin(); edge != contour->edges.end(); ++edge)
+                    edgeCurvatures.push_back(curvatureBound(*edge));
+            }
+        } else if (narrowBand && TrueDistance<typename ContourCombiner::EdgeSelectorType>::supported) {
+            // Distances further from zero than the distances mapped to 0 and 1 are outside the range.
+            DistanceMapping inverseMapping = transformation.distanceMapping.inverse();
+            bandRadius = (1+NARROW_BAND_MARGIN)*max(fabs(inverseMapping(0.)), fabs(inverseMapping(1.)));
+            saturatedValues[0] = clamp(float(transformation.distanceMapping(-bandRadius)));
+            saturatedValues[1] = clamp(float(transformation.distanceMapping(bandRadius)));
+            // Determine the orientation from the sign of the distance outside the shape's bounds, which is negative unless the orientation is reversed.
+            Shape::Bounds bounds = shape.getBounds();
+            Point2 outerPoint(bounds.l-(bounds.r-bounds.l)-1, bounds.b-(bounds.t-bounds.b)-1);
+            reverseOrientation = SimpleTrueShapeDistanceFinder::oneShotDistance(shape, outerPoint) > 0;
+        }
+        yBegin = shape.inverseYAxis ? height-region.y1 : region.y0;
+        yEnd = shape.inverseYAxis ? height-region.y0 : region.y1;
+        tilesX = (region.x1-region.x0+MSDFGEN_PARALLEL_TILE_SIZE-1)/MSDFGEN_PARALLEL_TILE_SIZE;
+        tilesY = (yEnd-yBegin+MSDFGEN_PARALLEL_TILE_SIZE-1)/MSDFGEN_PARALLEL_TILE_SIZE;
+        if (collectStatistics)
+            tileStatistics.resize(tileCount());
+        if (signCorrection) {
+            matchMap.resize(output.width*output.height);
+            ambiguousTiles.resize(tileCount());
+        }
+    }
+
+    /// Computes the scanlines of the rows if they are needed by the narrow band or sign correction. Must be called before the tiles are generated.
+    void computeScanlines(int threadCount) {
+        if (bandRadius > 0 || signCorrection) {
+            scanlines.resize(yEnd-yBegin);
+            ScanlineJob scanlineJob(scanlines, shape, transformation, yBegin, yEnd);
+            runParallelTasks(yEnd-yBegin, threadCount, scanlineJob);
+        }
+    }
+
+    /// Inverts the pixels whose sign is ambiguous if most of their neighbors have been inverted by sign correction, like distanceSignCorrection. Must be called after all tiles are generated.
+    void resolveAmbiguousSigns() {
+        for (int tile = 0; tile < (int) ambiguousTiles.size(); ++tile) {
+            if (!ambiguousTiles[tile])
+                continue;
+            int xBegin, yBegin, xEnd, yEnd;
+            tileBounds(tile, xBegin, yBegin, xEnd, yEnd);
+            for (int y = yBegin; y < yEnd; ++y) {
+                int row = (shape.inverseYAxis ? height-y-1 : y)-offsetY;
+                for (int x = xBegin-offsetX; x < xEnd-offsetX; ++x) {
+                    const char *match = &matchMap[x+output.width*row];
+                    if (!*match) {
+                        int neighborMatch = 0;
+                        if (x > 0) neighborMatch += *(match-1);
+                        if (x < output.width-1) neighborMatch += *(match+1);
+                        if (row > 0) neighborMatch += *(match-output.width);
+                        if (row < output.height-1) neighborMatch += *(match+output.width);
+                        if (neighborMatch < 0) {
+                            // Only multi-channel pixels can be ambiguous.
+                            T *msd = output(x, row);
+                            msd[0] = pixelFromFloat<T>(1.f-pixelToFloat(msd[0]));
+                            msd[1] = pixelFromFloat<T>(1.f-pixelToFloat(msd[1]));
+                            msd[2] = pixelFromFloat<T>(1.f-pixelToFloat(msd[2]));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /// Computes the pixel range [xBegin, xEnd) x [yBegin, yEnd) of the tile, where the Y-axis is not inverted.
+    inline void tileBounds(int tile, int &xBegin, int &yBegin, int &xEnd, int &yEnd) const {
+        xBegin = region.x0+MSDFGEN_PARALLEL_TILE_SIZE*(tile%tilesX);
+        yBegin = this->yBegin+MSDFGEN_PARALLEL_TILE_SIZE*(tile/tilesX);
+        xEnd = min(xBegin+MSDFGEN_PARALLEL_TILE_SIZE, region.x1);
+        yEnd = min(yBegin+MSDFGEN_PARALLEL_TILE_SIZE, this->yEnd);
+    }
+
+    inline int tileCount() const {
+        return tilesX*tilesY;
+    }
+
+    /// Returns the number of tiles in each row of tiles. The tiles are indexed row by row.
+    inline int tileRowLength() const {
+        return tilesX;
+    }
+
+    /// Adds the statistics of the distance queries of all tiles to total. Requires collectStatistics.
+    void addStatistics(EdgeCacheStatistics &total) const {
+        for (std::vector<EdgeCacheStatistics>::const_iterator it = tileStatistics.begin(); it != tileStatistics.end(); ++it) {
+            total.queryCount += it->queryCount;
+            total.evaluatedEdgeCount += it->evaluatedEdgeCount;
+            total.skippedEdgeCount += it->skippedEdgeCount;
+        }
+    }
+
+private:
+    BitmapRefType output;
+    const Shape &shape;
+    const SDFTransformation &transformation;
+    DistancePixelConversion<T, typename ContourCombiner::DistanceType> distancePixelConversion;
+    /// The edges of the shape shared by the distance finders of the workers.
+    CompiledShape compiledShape;
+    const ShapeBVH *bvh;
+    BitmapRegion region;
+    int offsetX, offsetY, height;
+    GeneratorConfig::TraversalOrder traversalOrder;
+    /// In narrow band mode, the absolute distance beyond which pixels are outside the distance range, otherwise zero.
+    double bandRadius;
+    /// The values of pixels outside the distance range on the outside and on the inside of the shape.
+    float saturatedValues[2];
+    bool reverseOrientation;
+    /// Sign correction - the fill rule, the scanline of each row (also used by the narrow band), whether the sign of each output pixel was kept (1), inverted (-1) or is ambiguous (0), and the tiles with ambiguous pixels.
+    bool signCorrection;
+    FillRule fillRule;
+    std::vector<Scanline> scanlines;
+    std::vector<char> matchMap;
+    std::vector<char> ambiguousTiles;
+    /// If not null, the nearest edge of each output pixel (see GeneratorConfig::nearestEdges).
+    int *nearestEdges;
+    /// In adaptive mode, the maximum interpolation error in shape units, otherwise zero.
+    double interpolationTolerance;
+    /// In adaptive mode, the hierarchy of the shape's edges, the bounds of their curvatures, and the index of each contour's first edge among them.
+    ShapeBVH edgeHierarchy;
+    std::vector<double> edgeCurvatures;
+    std::vector<int> contourEdgeOffsets;
+    std::vector<EdgeCacheStatistics> tileStatistics;
+    int yBegin, yEnd;
+    int tilesX, tilesY;
+
+};
+
+/// Generates the region of a distance field of the given height into output, which holds its pixels starting at (offsetX, offsetY).
+template <typename T, class ContourCombiner>
+void generateDistanceField(const typename DistancePixelConversion<T, typename ContourCombiner::DistanceType>::BitmapRefType &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, int offsetX, int offsetY, int height, const GeneratorConfig &config) {
+    if (region.empty())
+        return;
+    ShapeBVH bvh;
+    if (config.bvhAcceleration)
+        bvh.build(shape);
+    DistanceFieldGenerationJob<T, ContourCombiner> job(output, shape, transformation, config.bvhAcceleration ? &bvh : NULL, region, offsetX, offsetY, height, config.traversalOrder, config.narrowBand, config.adaptiveTolerance, config.cubicSearchTolerance, config.signCorrection, config.fillRule, config.nearestEdges, config.edgeCacheStatistics != NULL);
+    int threadCount = resolveThreadCount(config.threadCount);
+    job.computeScanlines(threadCount);
+    runParallelTasks(job.tileCount(), threadCount, job);
+    job.resolveAmbiguousSigns();
+    if (config.edgeCacheStatistics)
+        job.addStatistics(*config.edgeCacheStatistics);
+}
+
+template <template <typename> class EdgeSelector, typename T>
+void generateDistanceField(const typename DistancePixelConversion<T, typename EdgeSelector<double>::DistanceType>::BitmapRefType &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, int offsetX, int offsetY, int height, const GeneratorConfig &config) {
+    if (config.singlePrecision) {
+        if (config.overlapSupport)
+            generateDistanceField<T, OverlappingContourCombiner<EdgeSelector<float> > >(output, shape, transformation, region, offsetX, offsetY, height, config);
+        else
+            generateDistanceField<T, SimpleContourCombiner<EdgeSelector<float> > >(output, shape, transformation, region, offsetX, offsetY, height, config);
+    } else {
+        if (config.overlapSupport)
+            generateDistanceField<T, OverlappingContourCombiner<EdgeSelector<double> > >(output, shape, transformation, region, offsetX, offsetY, height, config);
+        else
+            generateDistanceField<T, SimpleContourCombiner<EdgeSelector<double> > >(output, shape, transformation, region, offsetX, offsetY, height, config);
+    }
+}
+
+template <template <typename> class EdgeSelector, typename T>
+void generateDistanceField(const typename DistancePixelConversion<T, typename EdgeSelector<double>::DistanceType>::BitmapRefType &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const GeneratorConfig &config) {
+    generateDistanceField<EdgeSelector, T>(output, shape, transformation, region.clamp(output.width, output.height), 0, 0, output.height, config);
+}
+
+template <template <typename> class EdgeSelector, typename T>
+void generateDistanceField(const typename DistancePixelConversion<T, typename EdgeSelector<double>::DistanceType>::BitmapRefType &output, const Shape &shape, const SDFTransformation &transformation, const GeneratorConfig &config) {
+    generateDistanceField<EdgeSelector, T>(output, shape, transformation, BitmapRegion(0, 0, output.width, output.height), 0, 0, output.height, config);
+}
+
+/// Runs the tasks [taskOffset, taskOffset+taskCount) of another job, such as a single row of its tiles.
+template <class Job>
+class TaskRangeJob {
+
+public:
+    class Worker {
+    public:
+        inline explicit Worker(TaskRangeJob &rangeJob) : worker(rangeJob.job), taskOffset(rangeJob.taskOffset) { }
+        inline void operator()(int task) {
+            worker(taskOffset+task);
+        }
+    private:
+        typename Job::Worker worker;
+        int taskOffset;
+    };
+
+    inline TaskRangeJob(Job &job, int taskOffset) : job(job), taskOffset(taskOffset) { }
+
+private:
+    Job &job;
+    int taskOffset;
+
+};
+
+/**
+ * Generates a whole multi-channel distance field and corrects it in a single pass over its rows of tiles.
+ * Each row of tiles is checked for errors as soon as its neighbor rows are generated, while they are still cached,
+ * and the errors are only applied after the next row has been checked, which still needs to read the uncorrected values.
+ * Because the section of each check includes the adjacent rows of texels, the result matches correcting the whole MSDF at once.
+ */
+template <class ContourCombiner, typename T, int N>
+void generateCorrectedDistanceField(const BitmapRef<T, N> &output, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config) {
+    const int maxSectionHeight = MSDFGEN_PARALLEL_TILE_SIZE+2;
+    BitmapRegion region(0, 0, output.width, output.height);
+    if (config.errorCorrection.buffer && 2*maxSectionHeight > output.height) {
+        // The two stencils would not fit into the provided buffer, which has a byte for each texel.
+        generateDistanceField<T, ContourCombiner>(output, shape, transformation, region, 0, 0, output.height, config);
+        msdfErrorCorrection(output, shape, transformation, config);
+        return;
+    }
+    Bitmap<byte, 1> stencilBuffer;
+    if (!config.errorCorrection.buffer)
+        stencilBuffer = Bitmap<byte, 1>(output.width, 2*maxSectionHeight);
+    // The stencils of the last two checked rows of tiles, which have not been applied yet, and the first rows of their sections.
+    byte *stencils[2];
+    stencils[0] = config.errorCorrection.buffer ? config.errorCorrection.buffer : (byte *) stencilBuffer;
+    stencils[1] = stencils[0]+output.width*maxSectionHeight;
+    int sectionBegins[2] = { };
+    ShapeBVH bvh;
+    if (config.bvhAcceleration)
+        bvh.build(shape);
+    DistanceFieldGenerationJob<T, ContourCombiner> job(output, shape, transformation, config.bvhAcceleration ? &bvh : NULL, region, 0, 0, output.height, config.traversalOrder, config.narrowBand, config.adaptiveTolerance, config.cubicSearchTolerance, false, config.fillRule, config.nearestEdges, config.edgeCacheStatistics != NULL);
+    int threadCount = resolveThreadCount(config.threadCount);
+    job.computeScanlines(threadCount);
+    int tileRowLength = job.tileRowLength();
+    int tileRowCount = tileRowLength ? job.tileCount()/tileRowLength : 0;
+    for (int tileRow = 0; tileRow < tileRowCount+2; ++tileRow) {
+        if (tileRow < tileRowCount) {
+            TaskRangeJob<DistanceFieldGenerationJob<T, ContourCombiner> > rowJob(job, tileRowLength*tileRow);
+            runParallelTasks(tileRowLength, threadCount, rowJob);
+        }
+        for (int i = 1; i <= 2; ++i) {
+            int checkedRow = tileRow-i;
+            if (checkedRow < 0 || checkedRow >= tileRowCount)
+                continue;
+            // The rows of texels of the row of tiles, which is flipped if the Y-axis is inverted.
+            int rowBegin = MSDFGEN_PARALLEL_TILE_SIZE*checkedRow;
+            int rowEnd = min(rowBegin+MSDFGEN_PARALLEL_TILE_SIZE, output.height);
+            if (shape.inverseYAxis) {
+                int flippedBegin = output.height-rowEnd;
+                rowEnd = output.height-rowBegin;
+                rowBegin = flippedBegin;
+            }
+            byte *stencil = stencils[checkedRow&1];
+            if (i == 1) {
+                // Check the row of tiles for errors in a section of the output extended by the adjacent rows of texels.
+                int sectionBegin = max(rowBegin-1, 0);
+                int sectionEnd = min(rowEnd+1, output.height);
+                BitmapConstRef<T, N> section(output(0, sectionBegin), output.width, sectionEnd-sectionBegin);
+                MSDFErrorCorrection ec(BitmapRef<byte, 1>(stencil, output.width, sectionEnd-sectionBegin), transformation);
+                ec.setSectionOffset(0, sectionBegin, output.height);
+                if (config.nearestEdges)
+                    ec.setNearestEdges(BitmapConstRef<int, 1>(config.nearestEdges, output.width, output.height));
+                ec.findErrors<N>(section, shape, config);
+                sectionBegins[checkedRow&1] = sectionBegin;
+            } else {
+                // The row of tiles is no longer read by the checks, apply its correction.
+                for (int y = rowBegin; y < rowEnd; ++y) {
+                    const byte *mask = stencil+output.width*(y-sectionBegins[checkedRow&1]);
+                    T *texel = output(0, y);
+                    for (int x = 0; x < output.width; ++x) {
+                        if (*mask&MSDFErrorCorrection::ERROR) {
+                            T m = median(texel[0], texel[1], texel[2]);
+                            texel[0] = m, texel[1] = m, texel[2] = m;
+                        }
+                        ++mask;
+                        texel += N;
+                    }
+                }
             }
-            rightToLeft = !rightToLeft;
         }
     }
+    if (config.edgeCacheStatistics)
+        job.addStatistics(*config.edgeCacheStatistics);
+}
+
+/// Returns the configuration of the error correction of a multi-channel distance field with sign correction, which cannot compare it to the distances of the shape, since they may have different signs.
+static MSDFGeneratorConfig signCorrectedErrorCorrectionConfig(const MSDFGeneratorConfig &config) {
+    MSDFGeneratorConfig correctionConfig(config);
+    correctionConfig.errorCorrection.distanceCheckMode = ErrorCorrectionConfig::DO_NOT_CHECK_DISTANCE;
+    return correctionConfig;
+}
+
+/// Generates and corrects a whole multi-channel distance field.
+template <template <typename> class EdgeSelector, typename T, int N>
+void generateMultiChannelDistanceField(const BitmapRef<T, N> &output, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config) {
+    if (config.errorCorrection.mode == ErrorCorrectionConfig::DISABLED) {
+        generateDistanceField<EdgeSelector, T>(output, shape, transformation, config);
+        return;
+    }
+    if (config.signCorrection) {
+        // The sign of ambiguous texels is only resolved once the whole distance field is generated, so it cannot be corrected row by row.
+        generateDistanceField<EdgeSelector, T>(output, shape, transformation, config);
+        msdfErrorCorrection(output, shape, transformation, signCorrectedErrorCorrectionConfig(config));
+        return;
+    }
+    if (config.singlePrecision) {
+        if (config.overlapSupport)
+            generateCorrectedDistanceField<OverlappingContourCombiner<EdgeSelector<float> > >(output, shape, transformation, config);
+        else
+            generateCorrectedDistanceField<SimpleContourCombiner<EdgeSelector<float> > >(output, shape, transformation, config);
+    } else {
+        if (config.overlapSupport)
+            generateCorrectedDistanceField<OverlappingContourCombiner<EdgeSelector<double> > >(output, shape, transformation, config);
+        else
+            generateCorrectedDistanceField<SimpleContourCombiner<EdgeSelector<double> > >(output, shape, transformation, config);
+    }
+}
+
+/// Generates and corrects the region of a multi-channel distance field. The region's halo is generated into a separate section so that the adjacent regions of the output are not modified.
+template <template <typename> class EdgeSelector, typename T, int N>
+void generateMultiChannelDistanceField(const BitmapRef<T, N> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config) {
+    BitmapRegion clampedRegion = region.clamp(output.width, output.height);
+    if (config.errorCorrection.mode == ErrorCorrectionConfig::DISABLED || clampedRegion.empty()) {
+        generateDistanceField<EdgeSelector, T>(output, shape, transformation, clampedRegion, 0, 0, output.height, config);
+        return;
+    }
+    if (clampedRegion.x0 == 0 && clampedRegion.y0 == 0 && clampedRegion.x1 == output.width && clampedRegion.y1 == output.height) {
+        generateMultiChannelDistanceField<EdgeSelector>(output, shape, transformation, config);
+        return;
+    }
+    BitmapRegion sectionRegion = clampedRegion.expand(max(config.errorCorrection.halo, 0)).clamp(output.width, output.height);
+    Bitmap<T, N> section(sectionRegion.x1-sectionRegion.x0, sectionRegion.y1-sectionRegion.y0);
+    generateDistanceField<EdgeSelector, T>(section, shape, transformation, sectionRegion, sectionRegion.x0, sectionRegion.y0, output.height, config);
+    msdfSectionErrorCorrection(section, shape, transformation, sectionRegion, clampedRegion, output.height, config.signCorrection ? signCorrectedErrorCorrectionConfig(config) : config);
+    for (int y = clampedRegion.y0; y < clampedRegion.y1; ++y)
+        memcpy(output(clampedRegion.x0, y), section(clampedRegion.x0-sectionRegion.x0, y-sectionRegion.y0), sizeof(T)*N*(clampedRegion.x1-clampedRegion.x0));
 }
 
 void generateSDF(const BitmapRef<float, 1> &output, const Shape &shape, const SDFTransformation &transformation, const GeneratorConfig &config) {
-    if (config.overlapSupport)
-        generateDistanceField<OverlappingContourCombiner<TrueDistanceSelector> >(output, shape, transformation);
-    else
-        generateDistanceField<SimpleContourCombiner<TrueDistanceSelector> >(output, shape, transformation);
+    generateDistanceField<BasicTrueDistanceSelector, float>(output, shape, transformation, config);
 }
 
 void generatePSDF(const BitmapRef<float, 1> &output, const Shape &shape, const SDFTransformation &transformation, const GeneratorConfig &config) {
-    if (config.overlapSupport)
-        generateDistanceField<OverlappingContourCombiner<PerpendicularDistanceSelector> >(output, shape, transformation);
-    else
-        generateDistanceField<SimpleContourCombiner<PerpendicularDistanceSelector> >(output, shape, transformation);
+    generateDistanceField<BasicPerpendicularDistanceSelector, float>(output, shape, transformation, config);
 }
 
 void generateMSDF(const BitmapRef<float, 3> &output, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config) {
-    if (config.overlapSupport)
-        generateDistanceField<OverlappingContourCombiner<MultiDistanceSelector> >(output, shape, transformation);
-    else
-        generateDistanceField<SimpleContourCombiner<MultiDistanceSelector> >(output, shape, transformation);
-    msdfErrorCorrection(output, shape, transformation, config);
+    generateMultiChannelDistanceField<BasicMultiDistanceSelector>(output, shape, transformation, config);
 }
 
 void generateMTSDF(const BitmapRef<float, 4> &output, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config) {
-    if (config.overlapSupport)
-        generateDistanceField<OverlappingContourCombiner<MultiAndTrueDistanceSelector> >(output, shape, transformation);
-    else
-        generateDistanceField<SimpleContourCombiner<MultiAndTrueDistanceSelector> >(output, shape, transformation);
-    msdfErrorCorrection(output, shape, transformation, config);
+    generateMultiChannelDistanceField<BasicMultiAndTrueDistanceSelector>(output, shape, transformation, config);
+}
+
+void generateSDF(const BitmapRef<float, 1> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const GeneratorConfig &config) {
+    generateDistanceField<BasicTrueDistanceSelector, float>(output, shape, transformation, region, config);
+}
+
+void generatePSDF(const BitmapRef<float, 1> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const GeneratorConfig &config) {
+    generateDistanceField<BasicPerpendicularDistanceSelector, float>(output, shape, transformation, region, config);
+}
+
+void generateMSDF(const BitmapRef<float, 3> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config) {
+    generateMultiChannelDistanceField<BasicMultiDistanceSelector>(output, shape, transformation, region, config);
+}
+
+void generateMTSDF(const BitmapRef<float, 4> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config) {
+    generateMultiChannelDistanceField<BasicMultiAndTrueDistanceSelector>(output, shape, transformation, region, config);
+}
+
+void generateSDF(const BitmapRef<byte, 1> &output, const Shape &shape, const SDFTransformation &transformation, const GeneratorConfig &config) {
+    generateDistanceField<BasicTrueDistanceSelector, byte>(output, shape, transformation, config);
+}
+
+void generatePSDF(const BitmapRef<byte, 1> &output, const Shape &shape, const SDFTransformation &transformation, const GeneratorConfig &config) {
+    generateDistanceField<BasicPerpendicularDistanceSelector, byte>(output, shape, transformation, config);
+}
+
+void generateMSDF(const BitmapRef<byte, 3> &output, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config) {
+    generateMultiChannelDistanceField<BasicMultiDistanceSelector>(output, shape, transformation, config);
+}
+
+void generateMTSDF(const BitmapRef<byte, 4> &output, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config) {
+    generateMultiChannelDistanceField<BasicMultiAndTrueDistanceSelector>(output, shape, transformation, config);
+}
+
+void generateSDF(const BitmapRef<byte, 1> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const GeneratorConfig &config) {
+    generateDistanceField<BasicTrueDistanceSelector, byte>(output, shape, transformation, region, config);
+}
+
+void generatePSDF(const BitmapRef<byte, 1> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const GeneratorConfig &config) {
+    generateDistanceField<BasicPerpendicularDistanceSelector, byte>(output, shape, transformation, region, config);
+}
+
+void generateMSDF(const BitmapRef<byte, 3> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config) {
+    generateMultiChannelDistanceField<BasicMultiDistanceSelector>(output, shape, transformation, region, config);
+}
+
+void generateMTSDF(const BitmapRef<byte, 4> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config) {
+    generateMultiChannelDistanceField<BasicMultiAndTrueDistanceSelector>(output, shape, transformation, region, config);
+}
+
+void generateSDF(const BitmapRef<uint16, 1> &output, const Shape &shape, const SDFTransformation &transformation, const GeneratorConfig &config) {
+    generateDistanceField<BasicTrueDistanceSelector, uint16>(output, shape, transformation, config);
+}
+
+void generatePSDF(const BitmapRef<uint16, 1> &output, const Shape &shape, const SDFTransformation &transformation, const GeneratorConfig &config) {
+    generateDistanceField<BasicPerpendicularDistanceSelector, uint16>(output, shape, transformation, config);
+}
+
+void generateMSDF(const BitmapRef<uint16, 3> &output, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config) {
+    generateMultiChannelDistanceField<BasicMultiDistanceSelector>(output, shape, transformation, config);
+}
+
+void generateMTSDF(const BitmapRef<uint16, 4> &output, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config) {
+    generateMultiChannelDistanceField<BasicMultiAndTrueDistanceSelector>(output, shape, transformation, config);
+}
+
+void generateSDF(const BitmapRef<uint16, 1> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const GeneratorConfig &config) {
+    generateDistanceField<BasicTrueDistanceSelector, uint16>(output, shape, transformation, region, config);
+}
+
+void generatePSDF(const BitmapRef<uint16, 1> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const GeneratorConfig &config) {
+    generateDistanceField<BasicPerpendicularDistanceSelector, uint16>(output, shape, transformation, region, config);
+}
+
+void generateMSDF(const BitmapRef<uint16, 3> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config) {
+    generateMultiChannelDistanceField<BasicMultiDistanceSelector>(output, shape, transformation, region, config);
+}
+
+void generateMTSDF(const BitmapRef<uint16, 4> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config) {
+    generateMultiChannelDistanceField<BasicMultiAndTrueDistanceSelector>(output, shape, transformation, region, config);
+}
+
+BitmapRegion getModifiedRegion(const Shape &shape, const SDFTransformation &transformation, int width, int height, int halo) {
+    const Shape::Bounds &bounds = shape.modifiedBounds;
+    if (bounds.l > bounds.r || bounds.b > bounds.t)
+        return BitmapRegion();
+    DistanceMapping inverseMapping = transformation.distanceMapping.inverse();
+    double range = max(fabs(inverseMapping(0.)), fabs(inverseMapping(1.)));
+    Point2 a = transformation.project(Point2(bounds.l-range, bounds.b-range));
+    Point2 b = transformation.project(Point2(bounds.r+range, bounds.t+range));
+    // Pixel (x, y) is evaluated at (x+.5, y+.5). The coordinates are clamped first so that they can be converted to integers.
+    BitmapRegion region(
+        (int) floor(clamp(min(a.x, b.x)-.5, -1., width+1.)),
+        (int) floor(clamp(min(a.y, b.y)-.5, -1., height+1.)),
+        (int) ceil(clamp(max(a.x, b.x)-.5, -1., width+1.))+1,
+        (int) ceil(clamp(max(a.y, b.y)-.5, -1., height+1.))+1
+    );
+    if (shape.inverseYAxis) {
+        int y0 = height-region.y1;
+        region.y1 = height-region.y0;
+        region.y0 = y0;
+    }
+    return region.expand(halo).clamp(width, height);
+}
+
+/// Generates the distance field of a job of generateDistanceFields using the given number of threads.
+static void generateDistanceField(const DistanceFieldJob &job, int threadCount) {
+    MSDFGeneratorConfig config = job.config;
+    config.threadCount = threadCount;
+    switch (job.type) {
+        case DistanceFieldJob::SDF:
+            generateSDF(BitmapRef<float, 1>(job.pixels, job.width, job.height), *job.shape, job.transformation, config);
+            break;
+        case DistanceFieldJob::PSDF:
+            generatePSDF(BitmapRef<float, 1>(job.pixels, job.width, job.height), *job.shape, job.transformation, config);
+            break;
+        case DistanceFieldJob::MSDF:
+            generateMSDF(BitmapRef<float, 3>(job.pixels, job.width, job.height), *job.shape, job.transformation, config);
+            break;
+        case DistanceFieldJob::MTSDF:
+            generateMTSDF(BitmapRef<float, 4>(job.pixels, job.width, job.height), *job.shape, job.transformation, config);
+            break;
+    }
+}
+
+/// Orders jobs of generateDistanceFields from the most to the least pixels.
+class DistanceFieldJobOrder {
+
+public:
+    inline explicit DistanceFieldJobOrder(const DistanceFieldJob *jobs) : jobs(jobs) { }
+    inline bool operator()(int a, int b) const {
+        return (long long) jobs[a].width*jobs[a].height > (long long) jobs[b].width*jobs[b].height;
+    }
+
+private:
+    const DistanceFieldJob *jobs;
+
+};
+
+/// Generates each of the selected jobs of generateDistanceFields whole in a single thread.
+class DistanceFieldBatchJob {
+
+public:
+    class Worker {
+    public:
+        inline explicit Worker(const DistanceFieldBatchJob &batch) : batch(batch) { }
+        inline void operator()(int task) {
+            generateDistanceField(batch.jobs[batch.jobIndices[task]], 1);
+        }
+    private:
+        const DistanceFieldBatchJob &batch;
+    };
+
+    inline DistanceFieldBatchJob(const DistanceFieldJob *jobs, const std::vector<int> &jobIndices) : jobs(jobs), jobIndices(jobIndices) { }
+
+private:
+    const DistanceFieldJob *jobs;
+    const std::vector<int> &jobIndices;
+
+};
+
+void generateDistanceFields(const DistanceFieldJob *jobs, int jobCount, int threadCount) {
+    threadCount = resolveThreadCount(threadCount);
+    std::vector<int> wholeJobs;
+    for (int i = 0; i < jobCount; ++i) {
+        // The rows of tiles of a job are processed one at a time, so all threads only take part if a row has a tile for each of them.
+        if (threadCount > 1 && (jobs[i].width+MSDFGEN_PARALLEL_TILE_SIZE-1)/MSDFGEN_PARALLEL_TILE_SIZE < threadCount)
+            wholeJobs.push_back(i);
+        else
+            generateDistanceField(jobs[i], threadCount);
+    }
+    // Starting with the largest jobs leaves the small ones to balance the load at the end.
+    std::stable_sort(wholeJobs.begin(), wholeJobs.end(), DistanceFieldJobOrder(jobs));
+    DistanceFieldBatchJob batch(jobs, wholeJobs);
+    runParallelTasks((int) wholeJobs.size(), threadCount, batch);
 }
 
 void generateSDF(const BitmapRef<float, 1> &output, const Shape &shape, const Projection &projection, Range range, const GeneratorConfig &config) {
-    if (config.overlapSupport)
-        generateDistanceField<OverlappingContourCombiner<TrueDistanceSelector> >(output, shape, SDFTransformation(projection, range));
-    else
-        generateDistanceField<SimpleContourCombiner<TrueDistanceSelector> >(output, shape, SDFTransformation(projection, range));
+    generateDistanceField<BasicTrueDistanceSelector, float>(output, shape, SDFTransformation(projection, range), config);
 }
 
 void generatePSDF(const BitmapRef<float, 1> &output, const Shape &shape, const Projection &projection, Range range, const GeneratorConfig &config) {
-    if (config.overlapSupport)
-        generateDistanceField<OverlappingContourCombiner<PerpendicularDistanceSelector> >(output, shape, SDFTransformation(projection, range));
-    else
-        generateDistanceField<SimpleContourCombiner<PerpendicularDistanceSelector> >(output, shape, SDFTransformation(projection, range));
+    generateDistanceField<BasicPerpendicularDistanceSelector, float>(output, shape, SDFTransformation(projection, range), config);
 }
 
 void generateMSDF(const BitmapRef<float, 3> &output, const Shape &shape, const Projection &projection, Range range, const MSDFGeneratorConfig &config) {
-    if (config.overlapSupport)
-        generateDistanceField<OverlappingContourCombiner<MultiDistanceSelector> >(output, shape, SDFTransformation(projection, range));
-    else
-        generateDistanceField<SimpleContourCombiner<MultiDistanceSelector> >(output, shape, SDFTransformation(projection, range));
-    msdfErrorCorrection(output, shape, SDFTransformation(projection, range), config);
+    generateMultiChannelDistanceField<BasicMultiDistanceSelector>(output, shape, SDFTransformation(projection, range), config);
 }
 
 void generateMTSDF(const BitmapRef<float, 4> &output, const Shape &shape, const Projection &projection, Range range, const MSDFGeneratorConfig &config) {
-    if (config.overlapSupport)
-        generateDistanceField<OverlappingContourCombiner<MultiAndTrueDistanceSelector> >(output, shape, SDFTransformation(projection, range));
-    else
-        generateDistanceField<SimpleContourCombiner<MultiAndTrueDistanceSelector> >(output, shape, SDFTransformation(projection, range));
-    msdfErrorCorrection(output, shape, SDFTransformation(projection, range), config);
+    generateMultiChannelDistanceField<BasicMultiAndTrueDistanceSelector>(output, shape, SDFTransformation(projection, range), config);
 }
 
 // Legacy API
@@ -13,4 +13,44 @@ inline float pixelByteToFloat(byte x) {
     return 1.f/255.f*float(x);
 }
 
+inline uint16 pixelFloatToUint16(float x) {
+    return uint16(~int(65535.5f-65535.f*clamp(x)));
+}
+
+inline float pixelUint16ToFloat(uint16 x) {
+    return 1.f/65535.f*float(x);
+}
+
+/// Converts a floating-point pixel value to pixel type T (float, byte, or uint16).
+template <typename T>
+inline T pixelFromFloat(float x);
+
+template <>
+inline float pixelFromFloat<float>(float x) {
+    return x;
+}
+
+template <>
+inline byte pixelFromFloat<byte>(float x) {
+    return pixelFloatToByte(x);
+}
+
+template <>
+inline uint16 pixelFromFloat<uint16>(float x) {
+    return pixelFloatToUint16(x);
+}
+
+/// Converts a pixel value of any of the supported pixel types to floating-point.
+inline float pixelToFloat(float x) {
+    return x;
+}
+
+inline float pixelToFloat(byte x) {
+    return pixelByteToFloat(x);
+}
+
+inline float pixelToFloat(uint16 x) {
+    return pixelUint16ToFloat(x);
+}
+
 }
@@ -1,26 +1,77 @@
 
 #include "rasterization.h"
 
+#include <algorithm>
 #include <vector>
 #include "arithmetics.hpp"
+#include "ScanlineSweep.h"
+#include "ThreadPool.h"
 
 namespace msdfgen {
 
-void rasterize(const BitmapRef<float, 1> &output, const Shape &shape, const Projection &projection, FillRule fillRule) {
-    Scanline scanline;
-    for (int y = 0; y < output.height; ++y) {
+/// Processes the rows of pixels of a bitmap in parallel bands of MSDFGEN_PARALLEL_TILE_SIZE rows. Each worker sweeps the scanlines of its rows with its own cursor and passes them to rowOperation(scanline, y, band).
+template <class RowOperation>
+class ScanlineBandJob {
+
+public:
+    class Worker {
+    public:
+        inline explicit Worker(ScanlineBandJob &job) : job(job), cursor(job.sweep) { }
+        void operator()(int band) {
+            int yEnd = min(MSDFGEN_PARALLEL_TILE_SIZE*(band+1), job.height);
+            for (int y = MSDFGEN_PARALLEL_TILE_SIZE*band; y < yEnd; ++y) {
+                cursor.scanline(scanline, y+.5);
+                job.rowOperation(scanline, y, band);
+            }
+        }
+    private:
+        ScanlineBandJob &job;
+        ScanlineSweep::Cursor cursor;
+        Scanline scanline;
+    };
+
+    inline ScanlineBandJob(const Shape &shape, const Projection &projection, int height, const RowOperation &rowOperation) : sweep(shape, projection, height), height(height), rowOperation(rowOperation) { }
+
+    inline int bandCount() const {
+        return (height+MSDFGEN_PARALLEL_TILE_SIZE-1)/MSDFGEN_PARALLEL_TILE_SIZE;
+    }
+
+private:
+    ScanlineSweep sweep;
+    int height;
+    const RowOperation &rowOperation;
+
+};
+
+template <class RowOperation>
+static void processScanlineBands(const Shape &shape, const Projection &projection, int height, const RowOperation &rowOperation, int threadCount) {
+    ScanlineBandJob<RowOperation> job(shape, projection, height, rowOperation);
+    runParallelTasks(job.bandCount(), resolveThreadCount(threadCount), job);
+}
+
+class RasterizationRow {
+    BitmapRef<float, 1> output;
+    const Shape &shape;
+    const Projection &projection;
+    FillRule fillRule;
+public:
+    inline RasterizationRow(const BitmapRef<float, 1> &output, const Shape &shape, const Projection &projection, FillRule fillRule) : output(output), shape(shape), projection(projection), fillRule(fillRule) { }
+    void operator()(const Scanline &scanline, int y, int) const {
         int row = shape.inverseYAxis ? output.height-y-1 : y;
-        shape.scanline(scanline, projection.unprojectY(y+.5));
         for (int x = 0; x < output.width; ++x)
             *output(x, row) = (float) scanline.filled(projection.unprojectX(x+.5), fillRule);
     }
-}
+};
 
-void distanceSignCorrection(const BitmapRef<float, 1> &sdf, const Shape &shape, const Projection &projection, FillRule fillRule) {
-    Scanline scanline;
-    for (int y = 0; y < sdf.height; ++y) {
+class SignCorrectionRow {
+    BitmapRef<float, 1> sdf;
+    const Shape &shape;
+    const Projection &projection;
+    FillRule fillRule;
+public:
+    inline SignCorrectionRow(const BitmapRef<float, 1> &sdf, const Shape &shape, const Projection &projection, FillRule fillRule) : sdf(sdf), shape(shape), projection(projection), fillRule(fillRule) { }
+    void operator()(const Scanline &scanline, int y, int) const {
         int row = shape.inverseYAxis ? sdf.height-y-1 : y;
-        shape.scanline(scanline, projection.unprojectY(y+.5));
         for (int x = 0; x < sdf.width; ++x) {
             bool fill = scanline.filled(projection.unprojectX(x+.5), fillRule);
             float &sd = *sdf(x, row);
@@ -28,27 +79,28 @@ void distanceSignCorrection(const BitmapRef<float, 1> &sdf, const Shape &shape,
                 sd = 1.f-sd;
         }
     }
-}
+};
 
+/// Corrects the signs of a row of a multi-channel distance field, and records in matchMap whether each texel was kept (1), inverted (-1) or has an ambiguous median (0), and in ambiguousBands whether the row's band has ambiguous texels.
 template <int N>
-static void multiDistanceSignCorrection(const BitmapRef<float, N> &sdf, const Shape &shape, const Projection &projection, FillRule fillRule) {
-    int w = sdf.width, h = sdf.height;
-    if (!(w*h))
-        return;
-    Scanline scanline;
-    bool ambiguous = false;
-    std::vector<char> matchMap;
-    matchMap.resize(w*h);
-    char *match = &matchMap[0];
-    for (int y = 0; y < h; ++y) {
-        int row = shape.inverseYAxis ? h-y-1 : y;
-        shape.scanline(scanline, projection.unprojectY(y+.5));
-        for (int x = 0; x < w; ++x) {
+class MultiSignCorrectionRow {
+    BitmapRef<float, N> sdf;
+    const Shape &shape;
+    const Projection &projection;
+    FillRule fillRule;
+    char *matchMap;
+    char *ambiguousBands;
+public:
+    inline MultiSignCorrectionRow(const BitmapRef<float, N> &sdf, const Shape &shape, const Projection &projection, FillRule fillRule, char *matchMap, char *ambiguousBands) : sdf(sdf), shape(shape), projection(projection), fillRule(fillRule), matchMap(matchMap), ambiguousBands(ambiguousBands) { }
+    void operator()(const Scanline &scanline, int y, int band) const {
+        int row = shape.inverseYAxis ? sdf.height-y-1 : y;
+        char *match = matchMap+sdf.width*y;
+        for (int x = 0; x < sdf.width; ++x) {
             bool fill = scanline.filled(projection.unprojectX(x+.5), fillRule);
             float *msd = sdf(x, row);
             float sd = median(msd[0], msd[1], msd[2]);
             if (sd == .5f)
-                ambiguous = true;
+                ambiguousBands[band] = true;
             else if ((sd > .5f) != fill) {
                 msd[0] = 1.f-msd[0];
                 msd[1] = 1.f-msd[1];
@@ -61,37 +113,87 @@ static void multiDistanceSignCorrection(const BitmapRef<float, N> &sdf, const Sh
             ++match;
         }
     }
-    // This step is necessary to avoid artifacts when whole shape is inverted
-    if (ambiguous) {
-        match = &matchMap[0];
-        for (int y = 0; y < h; ++y) {
-            int row = shape.inverseYAxis ? h-y-1 : y;
-            for (int x = 0; x < w; ++x) {
-                if (!*match) {
-                    int neighborMatch = 0;
-                    if (x > 0) neighborMatch += *(match-1);
-                    if (x < w-1) neighborMatch += *(match+1);
-                    if (y > 0) neighborMatch += *(match-w);
-                    if (y < h-1) neighborMatch += *(match+w);
-                    if (neighborMatch < 0) {
-                        float *msd = sdf(x, row);
-                        msd[0] = 1.f-msd[0];
-                        msd[1] = 1.f-msd[1];
-                        msd[2] = 1.f-msd[2];
+};
+
+/// Inverts the ambiguous texels of the bands that have them if most of their neighbors have been inverted. The match map is not modified, so the bands can be processed in any order.
+template <int N>
+class AmbiguityResolutionJob {
+
+public:
+    class Worker {
+    public:
+        inline explicit Worker(AmbiguityResolutionJob &job) : job(job) { }
+        void operator()(int band) {
+            if (!job.ambiguousBands[band])
+                return;
+            const BitmapRef<float, N> &sdf = job.sdf;
+            int w = sdf.width, h = sdf.height;
+            int yEnd = min(MSDFGEN_PARALLEL_TILE_SIZE*(band+1), h);
+            for (int y = MSDFGEN_PARALLEL_TILE_SIZE*band; y < yEnd; ++y) {
+                int row = job.inverseYAxis ? h-y-1 : y;
+                const char *match = job.matchMap+w*y;
+                for (int x = 0; x < w; ++x) {
+                    if (!*match) {
+                        int neighborMatch = 0;
+                        if (x > 0) neighborMatch += *(match-1);
+                        if (x < w-1) neighborMatch += *(match+1);
+                        if (y > 0) neighborMatch += *(match-w);
+                        if (y < h-1) neighborMatch += *(match+w);
+                        if (neighborMatch < 0) {
+                            float *msd = sdf(x, row);
+                            msd[0] = 1.f-msd[0];
+                            msd[1] = 1.f-msd[1];
+                            msd[2] = 1.f-msd[2];
+                        }
                     }
+                    ++match;
                 }
-                ++match;
             }
         }
+    private:
+        AmbiguityResolutionJob &job;
+    };
+
+    inline AmbiguityResolutionJob(const BitmapRef<float, N> &sdf, bool inverseYAxis, const char *matchMap, const char *ambiguousBands) : sdf(sdf), inverseYAxis(inverseYAxis), matchMap(matchMap), ambiguousBands(ambiguousBands) { }
+
+private:
+    BitmapRef<float, N> sdf;
+    bool inverseYAxis;
+    const char *matchMap;
+    const char *ambiguousBands;
+
+};
+
+void rasterize(const BitmapRef<float, 1> &output, const Shape &shape, const Projection &projection, FillRule fillRule, int threadCount) {
+    processScanlineBands(shape, projection, output.height, RasterizationRow(output, shape, projection, fillRule), threadCount);
+}
+
+void distanceSignCorrection(const BitmapRef<float, 1> &sdf, const Shape &shape, const Projection &projection, FillRule fillRule, int threadCount) {
+    processScanlineBands(shape, projection, sdf.height, SignCorrectionRow(sdf, shape, projection, fillRule), threadCount);
+}
+
+template <int N>
+static void multiDistanceSignCorrection(const BitmapRef<float, N> &sdf, const Shape &shape, const Projection &projection, FillRule fillRule, int threadCount) {
+    int w = sdf.width, h = sdf.height;
+    if (!(w*h))
+        return;
+    std::vector<char> matchMap(w*h);
+    int bandCount = (h+MSDFGEN_PARALLEL_TILE_SIZE-1)/MSDFGEN_PARALLEL_TILE_SIZE;
+    std::vector<char> ambiguousBands(bandCount);
+    processScanlineBands(shape, projection, h, MultiSignCorrectionRow<N>(sdf, shape, projection, fillRule, &matchMap[0], &ambiguousBands[0]), threadCount);
+    // This step is necessary to avoid artifacts when whole shape is inverted
+    if (std::find(ambiguousBands.begin(), ambiguousBands.end(), true) != ambiguousBands.end()) {
+        AmbiguityResolutionJob<N> job(sdf, shape.inverseYAxis, &matchMap[0], &ambiguousBands[0]);
+        runParallelTasks(bandCount, resolveThreadCount(threadCount), job);
     }
 }
 
-void distanceSignCorrection(const BitmapRef<float, 3> &sdf, const Shape &shape, const Projection &projection, FillRule fillRule) {
-    multiDistanceSignCorrection(sdf, shape, projection, fillRule);
+void distanceSignCorrection(const BitmapRef<float, 3> &sdf, const Shape &shape, const Projection &projection, FillRule fillRule, int threadCount) {
+    multiDistanceSignCorrection(sdf, shape, projection, fillRule, threadCount);
 }
 
-void distanceSignCorrection(const BitmapRef<float, 4> &sdf, const Shape &shape, const Projection &projection, FillRule fillRule) {
-    multiDistanceSignCorrection(sdf, shape, projection, fillRule);
+void distanceSignCorrection(const BitmapRef<float, 4> &sdf, const Shape &shape, const Projection &projection, FillRule fillRule, int threadCount) {
+    multiDistanceSignCorrection(sdf, shape, projection, fillRule, threadCount);
 }
 
 // Legacy API
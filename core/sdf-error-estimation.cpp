@@ -3,6 +3,7 @@
 
 #include <cmath>
 #include "arithmetics.hpp"
+#include "ScanlineSweep.h"
 
 namespace msdfgen {
 
@@ -140,12 +141,14 @@ double estimateSDFErrorInner(const BitmapConstRef<float, N> &sdf, const Shape &s
     double xTo = projection.unprojectX(sdf.width-.5);
     double overlapFactor = 1/(xTo-xFrom);
     double error = 0;
+    ScanlineSweep sweep(shape, projection, sdf.height);
+    ScanlineSweep::Cursor cursor(sweep);
     Scanline refScanline, sdfScanline;
     for (int row = 0; row < sdf.height-1; ++row) {
         for (int subRow = 0; subRow < scanlinesPerRow; ++subRow) {
             double bt = (subRow+.5)*subRowSize;
             double y = projection.unprojectY(row+bt+.5);
-            shape.scanline(refScanline, y);
+            cursor.scanline(refScanline, row+bt+.5);
             scanlineSDF(sdfScanline, sdf, projection, y, shape.inverseYAxis);
             error += 1-overlapFactor*Scanline::overlap(refScanline, sdfScanline, xFrom, xTo, fillRule);
         }
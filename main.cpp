@@ -392,8 +392,12 @@ static const char *const helpText =
     "\n"
     // Keep alphabetical order!
     "OPTIONS\n"
+    "  -adaptive <tolerance>\n"
+        "\tInterpolates the smooth regions of an SDF where the error is provably within the tolerance (in output pixel values).\n"
     "  -angle <angle>\n"
         "\tSpecifies the minimum angle between adjacent edges to be considered a corner. Append D for degrees.\n"
+    "  -approximatecubics <tolerance>\n"
+        "\tReplaces cubic curves with quadratic curves that approximate them within the tolerance (in output pixels).\n"
     "  -apxrange <outermost distance> <innermost distance>\n"
         "\tSpecifies the outermost (negative) and innermost representable distance in pixels.\n"
     "  -arange <outermost distance> <innermost distance>\n"
@@ -404,8 +408,12 @@ static const char *const helpText =
         "\tAutomatically scales (unless specified) and translates the shape to fit.\n"
     "  -coloringstrategy <simple / inktrap / distance>\n"
         "\tSelects the strategy of the edge coloring heuristic.\n"
+    "  -cubictolerance <tolerance>\n"
+        "\tAdapts the nearest point search on each cubic curve to the tolerance (in output pixels) instead of a fixed number of iterations.\n"
     "  -dimensions <width> <height>\n"
         "\tSets the dimensions of the output image.\n"
+    "  -edgecachestats\n"
+        "\tPrints how many edge distance computations were skipped thanks to the per-edge caches.\n"
     "  -edgecolors <sequence>\n"
         "\tOverrides automatic edge coloring with the specified color sequence.\n"
 #ifdef MSDFGEN_EXTENSIONS
@@ -438,6 +446,8 @@ static const char *const helpText =
         "\tDisplays this help.\n"
     "  -legacy\n"
         "\tUses the original (legacy) distance field algorithms.\n"
+    "  -narrowband\n"
+        "\tSkips the exact evaluation of SDF pixels that are provably outside the distance range, setting them to 0 or 1.\n"
 #ifdef MSDFGEN_EXTENSIONS
     "  -noemnormalize\n"
         "\tRaw integer font glyph coordinates will be used. Without this option, legacy scaling will be applied.\n"
@@ -469,10 +479,12 @@ static const char *const helpText =
         "\tSets the scale used to convert shape units to pixels.\n"
 #ifdef MSDFGEN_USE_SKIA
     "  -scanline\n"
-        "\tPerforms an additional scanline pass to fix the signs of the distances.\n"
+        "\tFixes the signs of the distances according to the selected fill rule using a scanline of each row.\n"
 #endif
     "  -seed <n>\n"
         "\tSets the random seed for edge coloring heuristic.\n"
+    "  -singleprecision\n"
+        "\tComputes the distances in single precision. Use with -estimateerror to compare the result against the default.\n"
     "  -stdout\n"
         "\tPrints the output instead of storing it in a file. Only text formats are supported.\n"
     "  -testrender <filename." DEFAULT_IMAGE_EXTENSION "> <width> <height>\n"
@@ -483,8 +495,12 @@ static const char *const helpText =
 #endif
     "  -testrendermulti <filename." DEFAULT_IMAGE_EXTENSION "> <width> <height>\n"
         "\tRenders an image preview without flattening the color channels.\n"
+    "  -threads <n>\n"
+        "\tSets the maximum number of threads used by a multithreaded build. Zero selects the number of hardware threads.\n"
     "  -translate <x> <y>\n"
         "\tSets the translation of the shape in shape units.\n"
+    "  -traversal <serpentine / morton / hilbert>\n"
+        "\tSets the order in which the pixels of each tile of the distance field are evaluated. Default is serpentine.\n"
     "  -version\n"
         "\tPrints the version of the program.\n"
     "  -windingpreprocess\n"
@@ -584,9 +600,11 @@ int main(int argc, const char *const *argv) {
     double angleThreshold = DEFAULT_ANGLE_THRESHOLD;
     float outputDistanceShift = 0.f;
     const char *edgeAssignment = NULL;
+    double cubicApproximationTolerance = 0;
     bool yFlip = false;
     bool printMetrics = false;
     bool estimateError = false;
+    EdgeCacheStatistics edgeCacheStatistics;
     bool skipColoring = false;
     enum {
         KEEP,
@@ -728,6 +746,35 @@ int main(int argc, const char *const *argv) {
             generatorConfig.overlapSupport = true;
             continue;
         }
+        ARG_CASE("-singleprecision", 0) {
+            generatorConfig.singlePrecision = true;
+            continue;
+        }
+        ARG_CASE("-narrowband", 0) {
+            generatorConfig.narrowBand = true;
+            continue;
+        }
+        ARG_CASE("-adaptive", 1) {
+            double tolerance;
+            if (!(parseDouble(tolerance, argv[argPos++]) && tolerance >= 0))
+                ABORT("Invalid adaptive tolerance. Use -adaptive <tolerance> with a non-negative real number.");
+            generatorConfig.adaptiveTolerance = tolerance;
+            continue;
+        }
+        ARG_CASE("-approximatecubics", 1) {
+            double tolerance;
+            if (!(parseDouble(tolerance, argv[argPos++]) && tolerance >= 0))
+                ABORT("Invalid cubic approximation tolerance. Use -approximatecubics <tolerance> with a non-negative real number.");
+            cubicApproximationTolerance = tolerance;
+            continue;
+        }
+        ARG_CASE("-cubictolerance", 1) {
+            double tolerance;
+            if (!(parseDouble(tolerance, argv[argPos++]) && tolerance >= 0))
+                ABORT("Invalid cubic search tolerance. Use -cubictolerance <tolerance> with a non-negative real number.");
+            generatorConfig.cubicSearchTolerance = tolerance;
+            continue;
+        }
         ARG_CASE("-noscanline", 0) {
             scanlinePass = false;
             continue;
@@ -962,6 +1009,10 @@ int main(int argc, const char *const *argv) {
             estimateError = true;
             continue;
         }
+        ARG_CASE("-edgecachestats", 0) {
+            generatorConfig.edgeCacheStatistics = &edgeCacheStatistics;
+            continue;
+        }
         ARG_CASE("-keeporder", 0) {
             orientation = KEEP;
             continue;
@@ -979,6 +1030,22 @@ int main(int argc, const char *const *argv) {
                 ABORT("Invalid seed. Use -seed <N> with N being a non-negative integer.");
             continue;
         }
+        ARG_CASE("-threads", 1) {
+            unsigned threadCount;
+            if (!parseUnsigned(threadCount, argv[argPos++]))
+                ABORT("Invalid thread count. Use -threads <N> with N being a non-negative integer.");
+            generatorConfig.threadCount = (int) threadCount;
+            continue;
+        }
+        ARG_CASE("-traversal", 1) {
+            if (ARG_IS("serpentine")) generatorConfig.traversalOrder = GeneratorConfig::SERPENTINE;
+            else if (ARG_IS("morton")) generatorConfig.traversalOrder = GeneratorConfig::MORTON;
+            else if (ARG_IS("hilbert")) generatorConfig.traversalOrder = GeneratorConfig::HILBERT;
+            else
+                fputs("Unknown traversal order specified.\n", stderr);
+            ++argPos;
+            continue;
+        }
         ARG_CASE("-version", 0) {
             puts(versionText);
             return 0;
@@ -1190,6 +1257,18 @@ int main(int argc, const char *const *argv) {
 
     // Compute output
     SDFTransformation transformation(Projection(scale, translate), range);
+    // The error is estimated with respect to the original shape
+    Shape originalShape;
+    if (cubicApproximationTolerance > 0) {
+        if (edgeAssignment && (mode == MULTI || mode == MULTI_AND_TRUE))
+            fputs("Note: Cubic curves won't be approximated because explicit edge colors were specified.\n", stderr);
+        else {
+            if (estimateError)
+                originalShape = shape;
+            shape.approximateCubics(cubicApproximationTolerance/max(scale.x, scale.y));
+        }
+    }
+    const Shape &errorReferenceShape = originalShape.contours.empty() ? shape : originalShape;
     Bitmap<float, 1> sdf;
     Bitmap<float, 3> msdf;
     Bitmap<float, 4> mtsdf;
@@ -1205,8 +1284,14 @@ int main(int argc, const char *const *argv) {
             }
             fprintf(stderr, "Selected error correction mode not compatible with scanline pass, falling back to %s.\n", fallbackModeName);
         }
-        generatorConfig.errorCorrection.mode = ErrorCorrectionConfig::DISABLED;
-        postErrorCorrectionConfig.errorCorrection.distanceCheckMode = ErrorCorrectionConfig::DO_NOT_CHECK_DISTANCE;
+        if (legacyMode) {
+            generatorConfig.errorCorrection.mode = ErrorCorrectionConfig::DISABLED;
+            postErrorCorrectionConfig.errorCorrection.distanceCheckMode = ErrorCorrectionConfig::DO_NOT_CHECK_DISTANCE;
+        } else {
+            // The signs are resolved while the distance field is generated, followed by the error correction without distance checks
+            generatorConfig.signCorrection = true;
+            generatorConfig.fillRule = fillRule;
+        }
     }
     switch (mode) {
         case SINGLE: {
@@ -1251,7 +1336,14 @@ int main(int argc, const char *const *argv) {
         }
         default:;
     }
+    if (generatorConfig.edgeCacheStatistics && !legacyMode) {
+        unsigned long long edgeCount = edgeCacheStatistics.evaluatedEdgeCount+edgeCacheStatistics.skippedEdgeCount;
+        printf("Edge cache: %llu queries, %llu of %llu edge distances skipped (%.1f%%)\n", edgeCacheStatistics.queryCount, edgeCacheStatistics.skippedEdgeCount, edgeCount, edgeCount ? 100.*double(edgeCacheStatistics.skippedEdgeCount)/double(edgeCount) : 0.);
+    }
 
+    // With sign correction, the signs are already determined by the fill rule regardless of orientation
+    if (generatorConfig.signCorrection)
+        orientation = KEEP;
     if (orientation == GUESS) {
         // Get sign of signed distance outside bounds
         Point2 p(bounds.l-(bounds.r-bounds.l)-1, bounds.b-(bounds.t-bounds.b)-1);
@@ -1273,7 +1365,7 @@ int main(int argc, const char *const *argv) {
             default:;
         }
     }
-    if (scanlinePass) {
+    if (scanlinePass && legacyMode) {
         switch (mode) {
             case SINGLE:
             case PERPENDICULAR:
@@ -1285,7 +1377,7 @@ int main(int argc, const char *const *argv) {
                 break;
             case MULTI_AND_TRUE:
                 distanceSignCorrection(mtsdf, shape, transformation, fillRule);
-                msdfErrorCorrection(msdf, shape, transformation, postErrorCorrectionConfig);
+                msdfErrorCorrection(mtsdf, shape, transformation, postErrorCorrectionConfig);
                 break;
             default:;
         }
@@ -1314,7 +1406,7 @@ int main(int argc, const char *const *argv) {
             if (is8bitFormat(format) && (testRenderMulti || testRender || estimateError))
                 simulate8bit(sdf);
             if (estimateError) {
-                double sdfError = estimateSDFError(sdf, shape, transformation, SDF_ERROR_ESTIMATE_PRECISION, fillRule);
+                double sdfError = estimateSDFError(sdf, errorReferenceShape, transformation, SDF_ERROR_ESTIMATE_PRECISION, fillRule);
                 printf("SDF error ~ %e\n", sdfError);
             }
             if (testRenderMulti) {
@@ -1338,7 +1430,7 @@ int main(int argc, const char *const *argv) {
             if (is8bitFormat(format) && (testRenderMulti || testRender || estimateError))
                 simulate8bit(msdf);
             if (estimateError) {
-                double sdfError = estimateSDFError(msdf, shape, transformation, SDF_ERROR_ESTIMATE_PRECISION, fillRule);
+                double sdfError = estimateSDFError(msdf, errorReferenceShape, transformation, SDF_ERROR_ESTIMATE_PRECISION, fillRule);
                 printf("SDF error ~ %e\n", sdfError);
             }
             if (testRenderMulti) {
@@ -1362,7 +1454,7 @@ int main(int argc, const char *const *argv) {
             if (is8bitFormat(format) && (testRenderMulti || testRender || estimateError))
                 simulate8bit(mtsdf);
             if (estimateError) {
-                double sdfError = estimateSDFError(mtsdf, shape, transformation, SDF_ERROR_ESTIMATE_PRECISION, fillRule);
+                double sdfError = estimateSDFError(mtsdf, errorReferenceShape, transformation, SDF_ERROR_ESTIMATE_PRECISION, fillRule);
                 printf("SDF error ~ %e\n", sdfError);
             }
             if (testRenderMulti) {
@@ -59,6 +59,26 @@ enum msdfgen_ErrorCorrectionConfig_DistanceCheckMode : msdfgen_Int {
     msdfgen_ErrorCorrectionConfig_Mode_AlwaysCheckDistance = 2
 };
 
+enum msdfgen_GeneratorConfig_TraversalOrder : msdfgen_Int {
+    msdfgen_GeneratorConfig_TraversalOrder_Serpentine = 0,
+    msdfgen_GeneratorConfig_TraversalOrder_Morton = 1,
+    msdfgen_GeneratorConfig_TraversalOrder_Hilbert = 2
+};
+
+enum msdfgen_FillRule : msdfgen_Int {
+    msdfgen_FillRule_NonZero = 0,
+    msdfgen_FillRule_Odd = 1,
+    msdfgen_FillRule_Positive = 2,
+    msdfgen_FillRule_Negative = 3
+};
+
+enum msdfgen_DistanceFieldJob_Type : msdfgen_Int {
+    msdfgen_DistanceFieldJob_Type_SDF = 0,
+    msdfgen_DistanceFieldJob_Type_PSDF = 1,
+    msdfgen_DistanceFieldJob_Type_MSDF = 2,
+    msdfgen_DistanceFieldJob_Type_MTSDF = 3
+};
+
 struct msdfgen_Vector2 {
     msdfgen_Double x, y;
 };
@@ -93,3 +113,13 @@ struct msdfgen_BitmapRef {
     msdfgen_Void* data;
     msdfgen_Int width, height;
 };
+
+struct msdfgen_BitmapRegion {
+    msdfgen_Int x0, y0, x1, y1;
+};
+
+struct msdfgen_EdgeCacheStatistics {
+    msdfgen_ULong queryCount;
+    msdfgen_ULong evaluatedEdgeCount;
+    msdfgen_ULong skippedEdgeCount;
+};
@@ -1,3 +1,6 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
 #include "msdfgen.h"
 
 #include "msdfgen-c.h"
@@ -217,6 +220,31 @@ msdfgen_EdgeSegmentHandle msdfgen_CubicSegment_toBase(msdfgen_CubicSegmentHandle
     return reinterpret_cast<msdfgen_EdgeSegmentHandle>(reinterpret_cast<msdfgen::CubicSegment*>(segment));
 }
 
+// Edge segment arena
+msdfgen_EdgeSegmentArenaHandle msdfgen_EdgeSegmentArena_create(msdfgen_Size blockSize) {
+    return reinterpret_cast<msdfgen_EdgeSegmentArenaHandle>(new msdfgen::EdgeSegmentArena(blockSize));
+}
+
+msdfgen_Void msdfgen_EdgeSegmentArena_destroy(msdfgen_EdgeSegmentArenaHandle arena) {
+    delete reinterpret_cast<msdfgen::EdgeSegmentArena*>(arena);
+}
+
+msdfgen_Void msdfgen_EdgeSegmentArena_reset(msdfgen_EdgeSegmentArenaHandle arena) {
+    reinterpret_cast<msdfgen::EdgeSegmentArena*>(arena)->reset();
+}
+
+msdfgen_Size msdfgen_EdgeSegmentArena_capacity(msdfgen_EdgeSegmentArenaHandle arena) {
+    return reinterpret_cast<msdfgen::EdgeSegmentArena*>(arena)->capacity();
+}
+
+msdfgen_EdgeSegmentArenaHandle msdfgen_EdgeSegmentArena_getCurrent() {
+    return reinterpret_cast<msdfgen_EdgeSegmentArenaHandle>(msdfgen::EdgeSegmentArena::current());
+}
+
+msdfgen_EdgeSegmentArenaHandle msdfgen_EdgeSegmentArena_setCurrent(msdfgen_EdgeSegmentArenaHandle arena) {
+    return reinterpret_cast<msdfgen_EdgeSegmentArenaHandle>(msdfgen::EdgeSegmentArena::setCurrent(reinterpret_cast<msdfgen::EdgeSegmentArena*>(arena)));
+}
+
 // Contour
 msdfgen_EdgeHolderHandle msdfgen_Contour_addEdge(msdfgen_ContourHandle contour) {
     msdfgen::EdgeHolder& edge = reinterpret_cast<msdfgen::Contour*>(contour)->addEdge();
@@ -262,6 +290,10 @@ msdfgen_Void msdfgen_Shape_normalize(msdfgen_ShapeHandle shape) {
     reinterpret_cast<msdfgen::Shape*>(shape)->normalize();
 }
 
+msdfgen_Void msdfgen_Shape_approximateCubics(msdfgen_ShapeHandle shape, msdfgen_Double tolerance) {
+    reinterpret_cast<msdfgen::Shape*>(shape)->approximateCubics(tolerance);
+}
+
 msdfgen_Bool msdfgen_Shape_validate(msdfgen_ShapeHandle shape) {
     return reinterpret_cast<msdfgen::Shape*>(shape)->validate();
 }
@@ -304,6 +336,23 @@ msdfgen_VectorViewHandle msdfgen_Shape_createContoursView(msdfgen_ShapeHandle sh
     return reinterpret_cast<msdfgen_VectorViewHandle>(new VectorView<msdfgen::Contour>(s->contours));
 }
 
+msdfgen_Void msdfgen_Shape_markModifiedEdge(msdfgen_ShapeHandle shape, msdfgen_EdgeSegmentHandle edge) {
+    reinterpret_cast<msdfgen::Shape*>(shape)->markModified(reinterpret_cast<msdfgen::EdgeSegment*>(edge));
+}
+
+msdfgen_Void msdfgen_Shape_markModifiedContour(msdfgen_ShapeHandle shape, msdfgen_ContourHandle contour) {
+    reinterpret_cast<msdfgen::Shape*>(shape)->markModified(*reinterpret_cast<msdfgen::Contour*>(contour));
+}
+
+msdfgen_Bounds msdfgen_Shape_getModifiedBounds(msdfgen_ShapeHandle shape) {
+    const msdfgen::Shape::Bounds& bounds = reinterpret_cast<msdfgen::Shape*>(shape)->modifiedBounds;
+    return { bounds.l, bounds.b, bounds.r, bounds.t };
+}
+
+msdfgen_Void msdfgen_Shape_clearModifiedBounds(msdfgen_ShapeHandle shape) {
+    reinterpret_cast<msdfgen::Shape*>(shape)->clearModifiedBounds();
+}
+
 // Distance mapping
 msdfgen_DistanceMapping msdfgen_DistanceMapping_createRange(msdfgen_Range range) {
     msdfgen::DistanceMapping mapping(msdfgen::Range(range.lower, range.upper));
@@ -416,9 +465,104 @@ msdfgen_Void msdfgen_GeneratorConfig_setOverlapSupport(msdfgen_GeneratorConfigHa
     reinterpret_cast<msdfgen::GeneratorConfig*>(config)->overlapSupport = overlapSupport;
 }
 
+msdfgen_Bool msdfgen_GeneratorConfig_getBVHAcceleration(msdfgen_GeneratorConfigHandle config) {
+    return reinterpret_cast<msdfgen::GeneratorConfig*>(config)->bvhAcceleration;
+}
+
+msdfgen_Void msdfgen_GeneratorConfig_setBVHAcceleration(msdfgen_GeneratorConfigHandle config, msdfgen_Bool bvhAcceleration) {
+    reinterpret_cast<msdfgen::GeneratorConfig*>(config)->bvhAcceleration = bvhAcceleration;
+}
+
+msdfgen_Bool msdfgen_GeneratorConfig_getSinglePrecision(msdfgen_GeneratorConfigHandle config) {
+    return reinterpret_cast<msdfgen::GeneratorConfig*>(config)->singlePrecision;
+}
+
+msdfgen_Void msdfgen_GeneratorConfig_setSinglePrecision(msdfgen_GeneratorConfigHandle config, msdfgen_Bool singlePrecision) {
+    reinterpret_cast<msdfgen::GeneratorConfig*>(config)->singlePrecision = singlePrecision;
+}
+
+msdfgen_Int msdfgen_GeneratorConfig_getThreadCount(msdfgen_GeneratorConfigHandle config) {
+    return reinterpret_cast<msdfgen::GeneratorConfig*>(config)->threadCount;
+}
+
+msdfgen_Void msdfgen_GeneratorConfig_setThreadCount(msdfgen_GeneratorConfigHandle config, msdfgen_Int threadCount) {
+    reinterpret_cast<msdfgen::GeneratorConfig*>(config)->threadCount = threadCount;
+}
+
+msdfgen_GeneratorConfig_TraversalOrder msdfgen_GeneratorConfig_getTraversalOrder(msdfgen_GeneratorConfigHandle config) {
+    return (msdfgen_GeneratorConfig_TraversalOrder)reinterpret_cast<msdfgen::GeneratorConfig*>(config)->traversalOrder;
+}
+
+msdfgen_Void msdfgen_GeneratorConfig_setTraversalOrder(msdfgen_GeneratorConfigHandle config, msdfgen_GeneratorConfig_TraversalOrder traversalOrder) {
+    reinterpret_cast<msdfgen::GeneratorConfig*>(config)->traversalOrder = (msdfgen::GeneratorConfig::TraversalOrder)traversalOrder;
+}
+
+msdfgen_Bool msdfgen_GeneratorConfig_getNarrowBand(msdfgen_GeneratorConfigHandle config) {
+    return reinterpret_cast<msdfgen::GeneratorConfig*>(config)->narrowBand;
+}
+
+msdfgen_Void msdfgen_GeneratorConfig_setNarrowBand(msdfgen_GeneratorConfigHandle config, msdfgen_Bool narrowBand) {
+    reinterpret_cast<msdfgen::GeneratorConfig*>(config)->narrowBand = narrowBand;
+}
+
+msdfgen_Double msdfgen_GeneratorConfig_getAdaptiveTolerance(msdfgen_GeneratorConfigHandle config) {
+    return reinterpret_cast<msdfgen::GeneratorConfig*>(config)->adaptiveTolerance;
+}
+
+msdfgen_Void msdfgen_GeneratorConfig_setAdaptiveTolerance(msdfgen_GeneratorConfigHandle config, msdfgen_Double adaptiveTolerance) {
+    reinterpret_cast<msdfgen::GeneratorConfig*>(config)->adaptiveTolerance = adaptiveTolerance;
+}
+
+msdfgen_Double msdfgen_GeneratorConfig_getCubicSearchTolerance(msdfgen_GeneratorConfigHandle config) {
+    return reinterpret_cast<msdfgen::GeneratorConfig*>(config)->cubicSearchTolerance;
+}
+
+msdfgen_Void msdfgen_GeneratorConfig_setCubicSearchTolerance(msdfgen_GeneratorConfigHandle config, msdfgen_Double cubicSearchTolerance) {
+    reinterpret_cast<msdfgen::GeneratorConfig*>(config)->cubicSearchTolerance = cubicSearchTolerance;
+}
+
+msdfgen_Bool msdfgen_GeneratorConfig_getSignCorrection(msdfgen_GeneratorConfigHandle config) {
+    return reinterpret_cast<msdfgen::GeneratorConfig*>(config)->signCorrection;
+}
+
+msdfgen_Void msdfgen_GeneratorConfig_setSignCorrection(msdfgen_GeneratorConfigHandle config, msdfgen_Bool signCorrection) {
+    reinterpret_cast<msdfgen::GeneratorConfig*>(config)->signCorrection = signCorrection;
+}
+
+msdfgen_FillRule msdfgen_GeneratorConfig_getFillRule(msdfgen_GeneratorConfigHandle config) {
+    return (msdfgen_FillRule)reinterpret_cast<msdfgen::GeneratorConfig*>(config)->fillRule;
+}
+
+msdfgen_Void msdfgen_GeneratorConfig_setFillRule(msdfgen_GeneratorConfigHandle config, msdfgen_FillRule fillRule) {
+    reinterpret_cast<msdfgen::GeneratorConfig*>(config)->fillRule = (msdfgen::FillRule)fillRule;
+}
+
+msdfgen_EdgeCacheStatistics* msdfgen_GeneratorConfig_getEdgeCacheStatistics(msdfgen_GeneratorConfigHandle config) {
+    return reinterpret_cast<msdfgen_EdgeCacheStatistics*>(reinterpret_cast<msdfgen::GeneratorConfig*>(config)->edgeCacheStatistics);
+}
+
+msdfgen_Void msdfgen_GeneratorConfig_setEdgeCacheStatistics(msdfgen_GeneratorConfigHandle config, msdfgen_EdgeCacheStatistics* statistics) {
+    reinterpret_cast<msdfgen::GeneratorConfig*>(config)->edgeCacheStatistics = reinterpret_cast<msdfgen::EdgeCacheStatistics*>(statistics);
+}
+
+msdfgen_Int* msdfgen_GeneratorConfig_getNearestEdges(msdfgen_GeneratorConfigHandle config) {
+    return reinterpret_cast<msdfgen::GeneratorConfig*>(config)->nearestEdges;
+}
+
+msdfgen_Void msdfgen_GeneratorConfig_setNearestEdges(msdfgen_GeneratorConfigHandle config, msdfgen_Int* nearestEdges) {
+    reinterpret_cast<msdfgen::GeneratorConfig*>(config)->nearestEdges = nearestEdges;
+}
+
 // MSDF generator config
+// The halo of ErrorCorrectionConfig is not part of msdfgen_ErrorCorrectionConfig, whose layout must stay the same, so the fields are copied individually.
+static msdfgen::ErrorCorrectionConfig toErrorCorrectionConfig(const msdfgen_ErrorCorrectionConfig* errorCorrectionConfig, int halo) {
+    msdfgen::ErrorCorrectionConfig cfg((msdfgen::ErrorCorrectionConfig::Mode)errorCorrectionConfig->mode, (msdfgen::ErrorCorrectionConfig::DistanceCheckMode)errorCorrectionConfig->distanceCheckMode, errorCorrectionConfig->minDeviationRatio, errorCorrectionConfig->minImproveRatio, reinterpret_cast<msdfgen::byte*>(errorCorrectionConfig->buffer));
+    cfg.halo = halo;
+    return cfg;
+}
+
 msdfgen_MSDFGeneratorConfigHandle msdfgen_MSDFGeneratorConfig_create(msdfgen_Bool overlapSupport, msdfgen_ErrorCorrectionConfig* errorCorrectionConfig) {
-    return reinterpret_cast<msdfgen_MSDFGeneratorConfigHandle>(new msdfgen::MSDFGeneratorConfig(overlapSupport, *reinterpret_cast<msdfgen::ErrorCorrectionConfig*>(errorCorrectionConfig)));
+    return reinterpret_cast<msdfgen_MSDFGeneratorConfigHandle>(new msdfgen::MSDFGeneratorConfig(overlapSupport, toErrorCorrectionConfig(errorCorrectionConfig, msdfgen::ErrorCorrectionConfig().halo)));
 }
 
 msdfgen_ErrorCorrectionConfig msdfgen_MSDFGeneratorConfig_getErrorCorrectionConfig(msdfgen_MSDFGeneratorConfigHandle config) {
@@ -427,7 +571,16 @@ msdfgen_ErrorCorrectionConfig msdfgen_MSDFGeneratorConfig_getErrorCorrectionConf
 }
 
 msdfgen_Void msdfgen_MSDFGeneratorConfig_setErrorCorrectionConfig(msdfgen_MSDFGeneratorConfigHandle config, msdfgen_ErrorCorrectionConfig* errorCorrectionConfig) {
-    reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config)->errorCorrection = *reinterpret_cast<msdfgen::ErrorCorrectionConfig*>(errorCorrectionConfig);
+    msdfgen::ErrorCorrectionConfig& cfg = reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config)->errorCorrection;
+    cfg = toErrorCorrectionConfig(errorCorrectionConfig, cfg.halo);
+}
+
+msdfgen_Int msdfgen_MSDFGeneratorConfig_getErrorCorrectionHalo(msdfgen_MSDFGeneratorConfigHandle config) {
+    return reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config)->errorCorrection.halo;
+}
+
+msdfgen_Void msdfgen_MSDFGeneratorConfig_setErrorCorrectionHalo(msdfgen_MSDFGeneratorConfigHandle config, msdfgen_Int halo) {
+    reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config)->errorCorrection.halo = halo;
 }
 
 // Edge coloring
@@ -459,3 +612,105 @@ msdfgen_Void msdfgen_generateMSDF(msdfgen_BitmapRef* output, msdfgen_ShapeHandle
 msdfgen_Void msdfgen_generateMTSDF(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_MSDFGeneratorConfigHandle config) {
     msdfgen::generateMTSDF(*reinterpret_cast<msdfgen::BitmapRef<float, 4>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config));
 }
+
+msdfgen_Void msdfgen_generateSDFRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_GeneratorConfigHandle config) {
+    msdfgen::generateSDF(*reinterpret_cast<msdfgen::BitmapRef<float, 1>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::BitmapRegion*>(region), *reinterpret_cast<msdfgen::GeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generatePSDFRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_GeneratorConfigHandle config) {
+    msdfgen::generatePSDF(*reinterpret_cast<msdfgen::BitmapRef<float, 1>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::BitmapRegion*>(region), *reinterpret_cast<msdfgen::GeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generateMSDFRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_MSDFGeneratorConfigHandle config) {
+    msdfgen::generateMSDF(*reinterpret_cast<msdfgen::BitmapRef<float, 3>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::BitmapRegion*>(region), *reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generateMTSDFRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_MSDFGeneratorConfigHandle config) {
+    msdfgen::generateMTSDF(*reinterpret_cast<msdfgen::BitmapRef<float, 4>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::BitmapRegion*>(region), *reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generateSDFByte(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_GeneratorConfigHandle config) {
+    msdfgen::generateSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::byte, 1>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::GeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generatePSDFByte(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_GeneratorConfigHandle config) {
+    msdfgen::generatePSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::byte, 1>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::GeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generateMSDFByte(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_MSDFGeneratorConfigHandle config) {
+    msdfgen::generateMSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::byte, 3>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generateMTSDFByte(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_MSDFGeneratorConfigHandle config) {
+    msdfgen::generateMTSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::byte, 4>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generateSDFByteRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_GeneratorConfigHandle config) {
+    msdfgen::generateSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::byte, 1>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::BitmapRegion*>(region), *reinterpret_cast<msdfgen::GeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generatePSDFByteRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_GeneratorConfigHandle config) {
+    msdfgen::generatePSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::byte, 1>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::BitmapRegion*>(region), *reinterpret_cast<msdfgen::GeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generateMSDFByteRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_MSDFGeneratorConfigHandle config) {
+    msdfgen::generateMSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::byte, 3>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::BitmapRegion*>(region), *reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generateMTSDFByteRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_MSDFGeneratorConfigHandle config) {
+    msdfgen::generateMTSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::byte, 4>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::BitmapRegion*>(region), *reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generateSDFUint16(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_GeneratorConfigHandle config) {
+    msdfgen::generateSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::uint16, 1>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::GeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generatePSDFUint16(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_GeneratorConfigHandle config) {
+    msdfgen::generatePSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::uint16, 1>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::GeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generateMSDFUint16(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_MSDFGeneratorConfigHandle config) {
+    msdfgen::generateMSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::uint16, 3>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generateMTSDFUint16(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_MSDFGeneratorConfigHandle config) {
+    msdfgen::generateMTSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::uint16, 4>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generateSDFUint16Region(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_GeneratorConfigHandle config) {
+    msdfgen::generateSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::uint16, 1>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::BitmapRegion*>(region), *reinterpret_cast<msdfgen::GeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generatePSDFUint16Region(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_GeneratorConfigHandle config) {
+    msdfgen::generatePSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::uint16, 1>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::BitmapRegion*>(region), *reinterpret_cast<msdfgen::GeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generateMSDFUint16Region(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_MSDFGeneratorConfigHandle config) {
+    msdfgen::generateMSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::uint16, 3>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::BitmapRegion*>(region), *reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config));
+}
+
+msdfgen_Void msdfgen_generateMTSDFUint16Region(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_MSDFGeneratorConfigHandle config) {
+    msdfgen::generateMTSDF(*reinterpret_cast<msdfgen::BitmapRef<msdfgen::uint16, 4>*>(output), *reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), *reinterpret_cast<msdfgen::BitmapRegion*>(region), *reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(config));
+}
+
+msdfgen_BitmapRegion msdfgen_getModifiedRegion(msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_Int width, msdfgen_Int height, msdfgen_Int halo) {
+    msdfgen::BitmapRegion region = msdfgen::getModifiedRegion(*reinterpret_cast<msdfgen::Shape*>(shape), *reinterpret_cast<msdfgen::SDFTransformation*>(transformation), width, height, halo);
+    return { region.x0, region.y0, region.x1, region.y1 };
+}
+
+msdfgen_Void msdfgen_generateDistanceFields(const msdfgen_DistanceFieldJob* jobs, msdfgen_Int jobCount, msdfgen_Int threadCount) {
+    std::vector<msdfgen::DistanceFieldJob> batch(jobCount);
+    for (msdfgen_Int i = 0; i < jobCount; ++i) {
+        batch[i].type = (msdfgen::DistanceFieldJob::Type)jobs[i].type;
+        batch[i].pixels = reinterpret_cast<float*>(jobs[i].output.data);
+        batch[i].width = jobs[i].output.width;
+        batch[i].height = jobs[i].output.height;
+        batch[i].shape = reinterpret_cast<const msdfgen::Shape*>(jobs[i].shape);
+        batch[i].transformation = *reinterpret_cast<msdfgen::SDFTransformation*>(jobs[i].transformation);
+        if (jobs[i].type == msdfgen_DistanceFieldJob_Type_MSDF || jobs[i].type == msdfgen_DistanceFieldJob_Type_MTSDF)
+            batch[i].config = *reinterpret_cast<msdfgen::MSDFGeneratorConfig*>(jobs[i].msdfConfig);
+        else
+            static_cast<msdfgen::GeneratorConfig&>(batch[i].config) = *reinterpret_cast<msdfgen::GeneratorConfig*>(jobs[i].config);
+    }
+    msdfgen::generateDistanceFields(batch.data(), jobCount, threadCount);
+}
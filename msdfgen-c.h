@@ -27,11 +27,22 @@ typedef struct msdfgen_EdgeSegment* msdfgen_EdgeSegmentHandle;
 typedef struct msdfgen_LinearSegment* msdfgen_LinearSegmentHandle;
 typedef struct msdfgen_QuadraticSegment* msdfgen_QuadraticSegmentHandle;
 typedef struct msdfgen_CubicSegment* msdfgen_CubicSegmentHandle;
+typedef struct msdfgen_EdgeSegmentArena* msdfgen_EdgeSegmentArenaHandle;
 typedef struct msdfgen_Projection* msdfgen_ProjectionHandle;
 typedef struct msdfgen_SDFTransformation* msdfgen_SDFTransformationHandle;
 typedef struct msdfgen_GeneratorConfig* msdfgen_GeneratorConfigHandle;
 typedef struct msdfgen_MSDFGeneratorConfig* msdfgen_MSDFGeneratorConfigHandle;
 
+// Distance field generated by msdfgen_generateDistanceFields, configured by config if it is an SDF or PSDF, or by msdfConfig if it is an MSDF or MTSDF
+struct msdfgen_DistanceFieldJob {
+    msdfgen_DistanceFieldJob_Type type;
+    msdfgen_BitmapRef output;
+    msdfgen_ShapeHandle shape;
+    msdfgen_SDFTransformationHandle transformation;
+    msdfgen_GeneratorConfigHandle config;
+    msdfgen_MSDFGeneratorConfigHandle msdfConfig;
+};
+
 // C API functions
 #ifdef __cplusplus
 extern "C" {
@@ -86,6 +97,14 @@ MSDFGEN_PUBLIC msdfgen_EdgeSegmentHandle      msdfgen_QuadraticSegment_toBase(ms
 MSDFGEN_PUBLIC msdfgen_CubicSegmentHandle msdfgen_CubicSegment_create(msdfgen_Point2 p0, msdfgen_Point2 p1, msdfgen_Point2 p2, msdfgen_Point2 p3, msdfgen_EdgeColor edgeColor);
 MSDFGEN_PUBLIC msdfgen_EdgeSegmentHandle  msdfgen_CubicSegment_toBase(msdfgen_CubicSegmentHandle segment);
 
+// Edge segment arena
+MSDFGEN_PUBLIC msdfgen_EdgeSegmentArenaHandle msdfgen_EdgeSegmentArena_create(msdfgen_Size blockSize);
+MSDFGEN_PUBLIC msdfgen_Void                   msdfgen_EdgeSegmentArena_destroy(msdfgen_EdgeSegmentArenaHandle arena);
+MSDFGEN_PUBLIC msdfgen_Void                   msdfgen_EdgeSegmentArena_reset(msdfgen_EdgeSegmentArenaHandle arena);
+MSDFGEN_PUBLIC msdfgen_Size                   msdfgen_EdgeSegmentArena_capacity(msdfgen_EdgeSegmentArenaHandle arena);
+MSDFGEN_PUBLIC msdfgen_EdgeSegmentArenaHandle msdfgen_EdgeSegmentArena_getCurrent();
+MSDFGEN_PUBLIC msdfgen_EdgeSegmentArenaHandle msdfgen_EdgeSegmentArena_setCurrent(msdfgen_EdgeSegmentArenaHandle arena);
+
 // Contour
 MSDFGEN_PUBLIC msdfgen_EdgeHolderHandle msdfgen_Contour_addEdge(msdfgen_ContourHandle contour);
 MSDFGEN_PUBLIC msdfgen_Void             msdfgen_Contour_bound(msdfgen_ContourHandle contour, msdfgen_Double* l, msdfgen_Double* b, msdfgen_Double* r, msdfgen_Double* t);
@@ -101,6 +120,7 @@ MSDFGEN_PUBLIC msdfgen_ShapeHandle      msdfgen_Shape_create();
 MSDFGEN_PUBLIC msdfgen_Void             msdfgen_Shape_destroy(msdfgen_ShapeHandle shape);
 MSDFGEN_PUBLIC msdfgen_ContourHandle    msdfgen_Shape_addContour(msdfgen_ShapeHandle shape);
 MSDFGEN_PUBLIC msdfgen_Void             msdfgen_Shape_normalize(msdfgen_ShapeHandle shape);
+MSDFGEN_PUBLIC msdfgen_Void             msdfgen_Shape_approximateCubics(msdfgen_ShapeHandle shape, msdfgen_Double tolerance);
 MSDFGEN_PUBLIC msdfgen_Bool             msdfgen_Shape_validate(msdfgen_ShapeHandle shape);
 MSDFGEN_PUBLIC msdfgen_Void             msdfgen_Shape_bound(msdfgen_ShapeHandle shape, msdfgen_Double* l, msdfgen_Double* b, msdfgen_Double* r, msdfgen_Double* t);
 MSDFGEN_PUBLIC msdfgen_Void             msdfgen_Shape_boundMiters(msdfgen_ShapeHandle shape, msdfgen_Double* l, msdfgen_Double* b, msdfgen_Double* r, msdfgen_Double* t, msdfgen_Double border, msdfgen_Double miterLimit, msdfgen_Int polarity);
@@ -111,6 +131,10 @@ MSDFGEN_PUBLIC msdfgen_Void             msdfgen_Shape_orientContours(msdfgen_Sha
 MSDFGEN_PUBLIC msdfgen_Bool             msdfgen_Shape_getInverseYAxis(msdfgen_ShapeHandle shape);
 MSDFGEN_PUBLIC msdfgen_Void             msdfgen_Shape_setInverseYAxis(msdfgen_ShapeHandle shape, msdfgen_Bool inverseYAxis);
 MSDFGEN_PUBLIC msdfgen_VectorViewHandle msdfgen_Shape_createContoursView(msdfgen_ShapeHandle shape);
+MSDFGEN_PUBLIC msdfgen_Void             msdfgen_Shape_markModifiedEdge(msdfgen_ShapeHandle shape, msdfgen_EdgeSegmentHandle edge);
+MSDFGEN_PUBLIC msdfgen_Void             msdfgen_Shape_markModifiedContour(msdfgen_ShapeHandle shape, msdfgen_ContourHandle contour);
+MSDFGEN_PUBLIC msdfgen_Bounds           msdfgen_Shape_getModifiedBounds(msdfgen_ShapeHandle shape);
+MSDFGEN_PUBLIC msdfgen_Void             msdfgen_Shape_clearModifiedBounds(msdfgen_ShapeHandle shape);
 
 // Distance mapping
 MSDFGEN_PUBLIC msdfgen_DistanceMapping msdfgen_DistanceMapping_createRange(msdfgen_Range range);
@@ -147,11 +171,36 @@ MSDFGEN_PUBLIC msdfgen_GeneratorConfigHandle msdfgen_GeneratorConfig_create(msdf
 MSDFGEN_PUBLIC msdfgen_Void                  msdfgen_GeneratorConfig_destroy(msdfgen_GeneratorConfigHandle config);
 MSDFGEN_PUBLIC msdfgen_Bool                  msdfgen_GeneratorConfig_getOverlapSupport(msdfgen_GeneratorConfigHandle config);
 MSDFGEN_PUBLIC msdfgen_Void                  msdfgen_GeneratorConfig_setOverlapSupport(msdfgen_GeneratorConfigHandle config, msdfgen_Bool overlapSupport);
+MSDFGEN_PUBLIC msdfgen_Bool                  msdfgen_GeneratorConfig_getBVHAcceleration(msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void                  msdfgen_GeneratorConfig_setBVHAcceleration(msdfgen_GeneratorConfigHandle config, msdfgen_Bool bvhAcceleration);
+MSDFGEN_PUBLIC msdfgen_Bool                  msdfgen_GeneratorConfig_getSinglePrecision(msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void                  msdfgen_GeneratorConfig_setSinglePrecision(msdfgen_GeneratorConfigHandle config, msdfgen_Bool singlePrecision);
+MSDFGEN_PUBLIC msdfgen_Int                   msdfgen_GeneratorConfig_getThreadCount(msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void                  msdfgen_GeneratorConfig_setThreadCount(msdfgen_GeneratorConfigHandle config, msdfgen_Int threadCount);
+MSDFGEN_PUBLIC msdfgen_GeneratorConfig_TraversalOrder msdfgen_GeneratorConfig_getTraversalOrder(msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void                  msdfgen_GeneratorConfig_setTraversalOrder(msdfgen_GeneratorConfigHandle config, msdfgen_GeneratorConfig_TraversalOrder traversalOrder);
+MSDFGEN_PUBLIC msdfgen_Bool                  msdfgen_GeneratorConfig_getNarrowBand(msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void                  msdfgen_GeneratorConfig_setNarrowBand(msdfgen_GeneratorConfigHandle config, msdfgen_Bool narrowBand);
+MSDFGEN_PUBLIC msdfgen_Double                msdfgen_GeneratorConfig_getAdaptiveTolerance(msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void                  msdfgen_GeneratorConfig_setAdaptiveTolerance(msdfgen_GeneratorConfigHandle config, msdfgen_Double adaptiveTolerance);
+MSDFGEN_PUBLIC msdfgen_Double                msdfgen_GeneratorConfig_getCubicSearchTolerance(msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void                  msdfgen_GeneratorConfig_setCubicSearchTolerance(msdfgen_GeneratorConfigHandle config, msdfgen_Double cubicSearchTolerance);
+MSDFGEN_PUBLIC msdfgen_Bool                  msdfgen_GeneratorConfig_getSignCorrection(msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void                  msdfgen_GeneratorConfig_setSignCorrection(msdfgen_GeneratorConfigHandle config, msdfgen_Bool signCorrection);
+MSDFGEN_PUBLIC msdfgen_FillRule              msdfgen_GeneratorConfig_getFillRule(msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void                  msdfgen_GeneratorConfig_setFillRule(msdfgen_GeneratorConfigHandle config, msdfgen_FillRule fillRule);
+MSDFGEN_PUBLIC msdfgen_EdgeCacheStatistics*  msdfgen_GeneratorConfig_getEdgeCacheStatistics(msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void                  msdfgen_GeneratorConfig_setEdgeCacheStatistics(msdfgen_GeneratorConfigHandle config, msdfgen_EdgeCacheStatistics* statistics);
+MSDFGEN_PUBLIC msdfgen_Int*                  msdfgen_GeneratorConfig_getNearestEdges(msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void                  msdfgen_GeneratorConfig_setNearestEdges(msdfgen_GeneratorConfigHandle config, msdfgen_Int* nearestEdges);
 
 // MSDF generator config
 MSDFGEN_PUBLIC msdfgen_MSDFGeneratorConfigHandle msdfgen_MSDFGeneratorConfig_create(msdfgen_Bool overlapSupport, msdfgen_ErrorCorrectionConfig* errorCorrectionConfig);
 MSDFGEN_PUBLIC msdfgen_ErrorCorrectionConfig     msdfgen_MSDFGeneratorConfig_getErrorCorrectionConfig(msdfgen_MSDFGeneratorConfigHandle config);
 MSDFGEN_PUBLIC msdfgen_Void                      msdfgen_MSDFGeneratorConfig_setErrorCorrectionConfig(msdfgen_MSDFGeneratorConfigHandle config, msdfgen_ErrorCorrectionConfig* errorCorrectionConfig);
+// The halo of the region error correction (1 by default) is not part of msdfgen_ErrorCorrectionConfig and is kept when it is set
+MSDFGEN_PUBLIC msdfgen_Int                       msdfgen_MSDFGeneratorConfig_getErrorCorrectionHalo(msdfgen_MSDFGeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void                      msdfgen_MSDFGeneratorConfig_setErrorCorrectionHalo(msdfgen_MSDFGeneratorConfigHandle config, msdfgen_Int halo);
 MSDFGEN_PUBLIC msdfgen_GeneratorConfigHandle     msdfgen_MSDFGeneratorConfig_toBase(msdfgen_MSDFGeneratorConfigHandle config);
 
 // Edge coloring
@@ -164,6 +213,29 @@ MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateSDF(msdfgen_BitmapRef* output, msdfg
 MSDFGEN_PUBLIC msdfgen_Void msdfgen_generatePSDF(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_GeneratorConfigHandle config);
 MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateMSDF(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_MSDFGeneratorConfigHandle config);
 MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateMTSDF(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_MSDFGeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateSDFRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generatePSDFRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateMSDFRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_MSDFGeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateMTSDFRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_MSDFGeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateSDFByte(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generatePSDFByte(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateMSDFByte(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_MSDFGeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateMTSDFByte(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_MSDFGeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateSDFByteRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generatePSDFByteRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateMSDFByteRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_MSDFGeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateMTSDFByteRegion(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_MSDFGeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateSDFUint16(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generatePSDFUint16(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateMSDFUint16(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_MSDFGeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateMTSDFUint16(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_MSDFGeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateSDFUint16Region(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generatePSDFUint16Region(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_GeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateMSDFUint16Region(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_MSDFGeneratorConfigHandle config);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateMTSDFUint16Region(msdfgen_BitmapRef* output, msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_BitmapRegion* region, msdfgen_MSDFGeneratorConfigHandle config);
+// Only covers the changes of an SDF clamped to [0, 1] (byte or uint16) of a shape without self-intersections - see msdfgen::getModifiedRegion
+MSDFGEN_PUBLIC msdfgen_BitmapRegion msdfgen_getModifiedRegion(msdfgen_ShapeHandle shape, msdfgen_SDFTransformationHandle transformation, msdfgen_Int width, msdfgen_Int height, msdfgen_Int halo);
+MSDFGEN_PUBLIC msdfgen_Void msdfgen_generateDistanceFields(const msdfgen_DistanceFieldJob* jobs, msdfgen_Int jobCount, msdfgen_Int threadCount);
 
 #ifdef __cplusplus
 }
@@ -23,7 +23,9 @@
 #include "core/DistanceMapping.h"
 #include "core/SDFTransformation.h"
 #include "core/Scanline.h"
+#include "core/EdgeSegmentArena.h"
 #include "core/Shape.h"
+#include "core/ScanlineSweep.h"
 #include "core/BitmapRef.hpp"
 #include "core/Bitmap.h"
 #include "core/bitmap-interpolation.hpp"
@@ -55,6 +57,66 @@ void generateMSDF(const BitmapRef<float, 3> &output, const Shape &shape, const S
 /// Generates a multi-channel signed distance field with true distance in the alpha channel. Edge colors must be assigned first.
 void generateMTSDF(const BitmapRef<float, 4> &output, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
 
+/// Generates only the pixels within the region of a conventional single-channel signed distance field. The remaining pixels of output are not accessed.
+void generateSDF(const BitmapRef<float, 1> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const GeneratorConfig &config = GeneratorConfig());
+/// Generates only the pixels within the region of a single-channel signed perpendicular distance field.
+void generatePSDF(const BitmapRef<float, 1> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const GeneratorConfig &config = GeneratorConfig());
+/// Generates only the pixels within the region of a multi-channel signed distance field. The error correction takes the region's halo into account, so that adjacent regions match the result of generating the whole MSDF at once.
+void generateMSDF(const BitmapRef<float, 3> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+/// Generates only the pixels within the region of a multi-channel signed distance field with true distance in the alpha channel.
+void generateMTSDF(const BitmapRef<float, 4> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+
+/// Generate distance fields directly quantized into 8-bit or 16-bit pixels, the same as converting the floating-point pixels with pixelFloatToByte or pixelFloatToUint16. Error correction operates on the quantized values.
+void generateSDF(const BitmapRef<byte, 1> &output, const Shape &shape, const SDFTransformation &transformation, const GeneratorConfig &config = GeneratorConfig());
+void generatePSDF(const BitmapRef<byte, 1> &output, const Shape &shape, const SDFTransformation &transformation, const GeneratorConfig &config = GeneratorConfig());
+void generateMSDF(const BitmapRef<byte, 3> &output, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void generateMTSDF(const BitmapRef<byte, 4> &output, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void generateSDF(const BitmapRef<byte, 1> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const GeneratorConfig &config = GeneratorConfig());
+void generatePSDF(const BitmapRef<byte, 1> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const GeneratorConfig &config = GeneratorConfig());
+void generateMSDF(const BitmapRef<byte, 3> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void generateMTSDF(const BitmapRef<byte, 4> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void generateSDF(const BitmapRef<uint16, 1> &output, const Shape &shape, const SDFTransformation &transformation, const GeneratorConfig &config = GeneratorConfig());
+void generatePSDF(const BitmapRef<uint16, 1> &output, const Shape &shape, const SDFTransformation &transformation, const GeneratorConfig &config = GeneratorConfig());
+void generateMSDF(const BitmapRef<uint16, 3> &output, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void generateMTSDF(const BitmapRef<uint16, 4> &output, const Shape &shape, const SDFTransformation &transformation, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void generateSDF(const BitmapRef<uint16, 1> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const GeneratorConfig &config = GeneratorConfig());
+void generatePSDF(const BitmapRef<uint16, 1> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const GeneratorConfig &config = GeneratorConfig());
+void generateMSDF(const BitmapRef<uint16, 3> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+void generateMTSDF(const BitmapRef<uint16, 4> &output, const Shape &shape, const SDFTransformation &transformation, const BitmapRegion &region, const MSDFGeneratorConfig &config = MSDFGeneratorConfig());
+
+/// Returns the region of a conventional signed distance field (generateSDF) with the given dimensions that has to be regenerated after the edits recorded in shape.modifiedBounds - their bounds widened by the distance range and by halo pixels.
+/// It only covers every pixel that can change for values clamped to [0, 1] (byte and uint16 bitmaps) of shapes whose contours do not intersect themselves, nor each other without overlap support. Unclamped floating-point values may also change outside the region.
+/// Pseudo-distance fields (PSDF, MSDF, MTSDF) may change anywhere, because a modified edge can be selected by its perpendicular distance far from its bounds, so they have to be regenerated in full.
+BitmapRegion getModifiedRegion(const Shape &shape, const SDFTransformation &transformation, int width, int height, int halo = 1);
+
+/// A distance field to be generated by generateDistanceFields.
+struct DistanceFieldJob {
+    /// The kind of the distance field, which determines the number of channels of the output.
+    enum Type {
+        /// Conventional single-channel signed distance field (see generateSDF).
+        SDF,
+        /// Single-channel signed perpendicular distance field (see generatePSDF).
+        PSDF,
+        /// Multi-channel signed distance field (see generateMSDF).
+        MSDF,
+        /// Multi-channel signed distance field with true distance in the alpha channel (see generateMTSDF).
+        MTSDF
+    } type;
+    /// The output bitmap, whose pixels have 1 (SDF, PSDF), 3 (MSDF), or 4 (MTSDF) channels.
+    float *pixels;
+    int width, height;
+    /// The shape, which must persist until generateDistanceFields returns.
+    const Shape *shape;
+    SDFTransformation transformation;
+    /// The configuration of the generator, where errorCorrection only applies to MSDF and MTSDF, and threadCount is ignored. Jobs must not share edgeCacheStatistics.
+    MSDFGeneratorConfig config;
+
+    inline DistanceFieldJob() : type(MSDF), pixels(NULL), width(0), height(0), shape(NULL) { }
+};
+
+/// Generates the distance fields of all jobs and returns when they are complete. Using at most threadCount threads (zero selects the backend's default), jobs too narrow to occupy all threads are each generated whole by a single thread, while the others are split into tiles between all threads.
+void generateDistanceFields(const DistanceFieldJob *jobs, int jobCount, int threadCount = 0);
+
 // Old version of the function API's kept for backwards compatibility
 void generateSDF(const BitmapRef<float, 1> &output, const Shape &shape, const Projection &projection, Range range, const GeneratorConfig &config = GeneratorConfig());
 void generatePSDF(const BitmapRef<float, 1> &output, const Shape &shape, const Projection &projection, Range range, const GeneratorConfig &config = GeneratorConfig());
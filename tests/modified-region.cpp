@@ -0,0 +1,85 @@
+#define _USE_MATH_DEFINES
+#include <cstdio>
+#include <cmath>
+#include "msdfgen.h"
+
+using namespace msdfgen;
+
+// Checks that regenerating the region returned by getModifiedRegion after an edit yields the same byte SDF as regenerating all of it.
+
+static unsigned randomState = 1;
+
+static double randomValue() {
+    randomState = 1664525u*randomState+1013904223u;
+    return double(randomState>>8)/double(1u<<24);
+}
+
+/// Adds a contour around the center whose vertices are at random radii, with linear, quadratic, and cubic edges that bulge slightly outwards.
+static void addRadialContour(Shape &shape, Point2 center, double radius, int edgeCount) {
+    Contour &contour = shape.addContour();
+    Point2 start = center+radius*Vector2(1, 0), p0 = start;
+    for (int i = 0; i < edgeCount; ++i) {
+        double angle = 2*M_PI*(i+1)/edgeCount;
+        Point2 p1 = i == edgeCount-1 ? start : center+radius*(.75+.25*randomValue())*Vector2(cos(angle), sin(angle));
+        Vector2 bulge = .1*(p1-p0).getOrthogonal(false);
+        switch (i%3) {
+            case 0:
+                contour.addEdge(EdgeHolder(p0, p1));
+                break;
+            case 1:
+                contour.addEdge(EdgeHolder(p0, .5*(p0+p1)+bulge, p1));
+                break;
+            default:
+                contour.addEdge(EdgeHolder(p0, p0+(p1-p0)/3.+bulge, p0+2.*(p1-p0)/3.+bulge, p1));
+        }
+        p0 = p1;
+    }
+}
+
+/// Returns the number of pixels that differ between the fully regenerated SDF and the one where only the modified region has been regenerated after moving the inner control point of a curved edge.
+static int compareModifiedRegion(Shape &shape, EdgeSegment *edge, Vector2 offset, int width, int height, const SDFTransformation &transformation, bool overlapSupport) {
+    Bitmap<byte, 1> full(width, height), partial(width, height);
+    GeneratorConfig config(overlapSupport);
+    generateSDF(partial, shape, transformation, config);
+    shape.clearModifiedBounds();
+    shape.markModified(edge);
+    if (edge->type() == (int) QuadraticSegment::EDGE_TYPE)
+        static_cast<QuadraticSegment *>(edge)->p[1] += offset;
+    else
+        static_cast<CubicSegment *>(edge)->p[1] += offset;
+    shape.markModified(edge);
+    generateSDF(full, shape, transformation, config);
+    generateSDF(partial, shape, transformation, getModifiedRegion(shape, transformation, width, height), config);
+    int differences = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (*full(x, y) != *partial(x, y))
+                ++differences;
+        }
+    }
+    return differences;
+}
+
+int main() {
+    int failures = 0;
+    for (int i = 0; i < 8; ++i) {
+        Shape shape;
+        addRadialContour(shape, Point2(5, 6), 4, 4+i);
+        addRadialContour(shape, Point2(13, 10), 3, 3+i);
+        if (i&1) {
+            // Overlaps the first contour, so the combination is only consistent with overlap support
+            addRadialContour(shape, Point2(8, 4), 3, 5+i);
+        }
+        shape.normalize();
+        SDFTransformation transformation(Projection(Vector2(4), Vector2(1, 1)), Range(.5+.25*i));
+        for (int overlapSupport = i&1; overlapSupport < 2; ++overlapSupport) {
+            Shape editedShape(shape);
+            int differences = compareModifiedRegion(editedShape, editedShape.contours[0].edges[1+i%2], Vector2(.5-randomValue(), .5-randomValue()), 75, 69, transformation, overlapSupport != 0);
+            if (differences) {
+                printf("Shape %d (overlap support %s): %d pixels outside the modified region differ\n", i, overlapSupport ? "on" : "off", differences);
+                ++failures;
+            }
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+
+#define _USE_MATH_DEFINES
+#include <cstdio>
+#include <cmath>
+#include "msdfgen.h"
+
+using namespace msdfgen;
+
+// Checks that narrow-band generation of true signed distance fields leaves the pixels inside the distance range unchanged.
+
+static unsigned randomState = 1;
+
+static double randomValue() {
+    randomState = 1664525u*randomState+1013904223u;
+    return double(randomState>>8)/double(1u<<24);
+}
+
+static Point2 randomPoint(double size) {
+    return Point2(size*randomValue(), size*randomValue());
+}
+
+/// Adds a self-intersecting star polygon.
+static void addStar(Shape &shape, Point2 center, double radius, int points, int step) {
+    Contour &contour = shape.addContour();
+    for (int i = 0; i < points; ++i) {
+        double a0 = 2*M_PI*i*step/points, a1 = 2*M_PI*(i+1)*step/points;
+        contour.addEdge(EdgeHolder(center+radius*Vector2(cos(a0), sin(a0)), center+radius*Vector2(cos(a1), sin(a1))));
+    }
+}
+
+/// Adds overlapping closed contours with random linear, quadratic, and cubic edges.
+static void addRandomContours(Shape &shape, int contourCount, int edgeCount, double size) {
+    for (int i = 0; i < contourCount; ++i) {
+        Contour &contour = shape.addContour();
+        Point2 start = randomPoint(size), p0 = start;
+        for (int j = 0; j < edgeCount; ++j) {
+            Point2 p1 = j == edgeCount-1 ? start : randomPoint(size);
+            switch (j%3) {
+                case 0:
+                    contour.addEdge(EdgeHolder(p0, p1));
+                    break;
+                case 1:
+                    contour.addEdge(EdgeHolder(p0, randomPoint(size), p1));
+                    break;
+                default:
+                    contour.addEdge(EdgeHolder(p0, randomPoint(size), randomPoint(size), p1));
+            }
+            p0 = p1;
+        }
+    }
+}
+
+/// Returns the number of pixels inside the distance range of the exact SDF that differ in the narrow-band SDF.
+static int compareNarrowBand(const Shape &shape, int width, int height, const SDFTransformation &transformation, bool overlapSupport) {
+    Bitmap<float, 1> exact(width, height), narrowBand(width, height);
+    GeneratorConfig config(overlapSupport);
+    generateSDF(exact, shape, transformation, config);
+    config.narrowBand = true;
+    generateSDF(narrowBand, shape, transformation, config);
+    int differences = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            float value = *exact(x, y);
+            if (value > 0.f && value < 1.f && *narrowBand(x, y) != value)
+                ++differences;
+        }
+    }
+    return differences;
+}
+
+int main() {
+    int failures = 0;
+    for (int i = 0; i < 8; ++i) {
+        Shape shape;
+        if (i&1)
+            addStar(shape, Point2(8, 8), 6+.5*i, 5+2*(i/2), 2+i/4);
+        addRandomContours(shape, 2+i/2, 3+2*i, 16);
+        shape.normalize();
+        SDFTransformation transformation(Projection(Vector2(4), Vector2(1, 1)), Range(.5+.25*i));
+        for (int overlapSupport = 0; overlapSupport < 2; ++overlapSupport) {
+            int differences = compareNarrowBand(shape, 75, 69, transformation, overlapSupport != 0);
+            if (differences) {
+                printf("Shape %d (overlap support %s): %d pixels inside the range differ\n", i, overlapSupport ? "on" : "off", differences);
+                ++failures;
+            }
+        }
+    }
+    return failures ? 1 : 0;
+}